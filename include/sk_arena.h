@@ -0,0 +1,95 @@
+/*
+ * sk_arena.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_ARENA_H_
+#define SK_ARENA_H_
+
+// UINT_64, UINT_8, bool
+#include "sk_types/sk_types.h"
+
+/**
+ * Region allocator for objects sharing one lifetime. Memory is carved sequentially out of
+ *  large chunks and is only given back all at once by sk_arena_destroy, so releasing
+ *  everything a search allocated costs one free per chunk rather than one per object.
+ */
+typedef struct sk_arena
+{
+    UINT_64 chunk_size;         // Default size of a chunk in bytes
+    UINT_8 *chunk;              // Current chunk. Its first bytes link to the previous chunk.
+    UINT_64 used;               // Bytes handed out from the current chunk, header included
+    UINT_64 capacity;           // Size of the current chunk
+
+    // Statistics
+    UINT_64 chunks;             // Chunks allocated
+    UINT_64 bytes;              // Bytes requested from the system
+} sk_arena;
+
+/**
+ * Fixed size object pool carved out of an arena. Released objects are threaded onto a
+ *  free list and handed out again before the arena is asked for more memory.
+ */
+typedef struct sk_pool
+{
+    sk_arena *arena;
+    UINT_64 object_size;        // Rounded up to the arena alignment
+    void *free_list;
+} sk_pool;
+
+/**
+ * @brief                   Initializes an empty arena.
+ *
+ * @param[out] arena        - Arena to initialize
+ * @param[in] chunk_size    - Preferred size of each chunk in bytes
+ */
+void sk_arena_init(sk_arena *arena, UINT_64 chunk_size);
+
+/**
+ * @brief                   Allocates \c size bytes from \c arena. The memory is suitably
+ *                              aligned for any type and is not zeroed.
+ *
+ * @param[in] arena         - Arena to allocate from
+ * @param[in] size          - Number of bytes required
+ *
+ * @return                  The allocation, or NULL if the system is out of memory.
+ */
+void *sk_arena_alloc(sk_arena *arena, UINT_64 size);
+
+/**
+ * @brief                   Frees every chunk of \c arena, and with them every object
+ *                              allocated from it or from its pools.
+ *
+ * @param[in] arena         - Arena to destroy
+ */
+void sk_arena_destroy(sk_arena *arena);
+
+/**
+ * @brief                   Initializes a pool of \c object_size byte objects drawn from \c arena.
+ *
+ * @param[out] pool         - Pool to initialize
+ * @param[in] arena         - Arena backing the pool
+ * @param[in] object_size   - Size in bytes of every object
+ */
+void sk_pool_init(sk_pool *pool, sk_arena *arena, UINT_64 object_size);
+
+/**
+ * @brief                   Allocates one object from \c pool, reusing a released one if possible.
+ *
+ * @param[in] pool          - Pool to allocate from
+ *
+ * @return                  The object, or NULL if the system is out of memory.
+ */
+void *sk_pool_alloc(sk_pool *pool);
+
+/**
+ * @brief                   Returns \c object to \c pool for reuse.
+ *
+ * @param[in] pool          - Pool \c object was allocated from
+ * @param[in] object        - Object to release
+ */
+void sk_pool_free(sk_pool *pool, void *object);
+
+#endif /* SK_ARENA_H_ */
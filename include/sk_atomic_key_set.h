@@ -0,0 +1,105 @@
+/*
+ * sk_atomic_key_set.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_ATOMIC_KEY_SET_H_
+#define SK_ATOMIC_KEY_SET_H_
+
+// UINT_64, UINT_8, bool
+#include "sk_types/sk_types.h"
+
+// _Atomic
+#include <stdatomic.h>
+
+// Results of sk_atomic_key_set_insert
+#define SK_KEY_SET_PRESENT      0
+#define SK_KEY_SET_INSERTED     1
+#define SK_KEY_SET_FULL         2
+
+/**
+ * One pre-sized segment of an atomic key set. Segments are padded apart so that their
+ *  counters do not share a cache line.
+ */
+typedef struct sk_key_segment
+{
+    _Atomic UINT_64 count;      // Slots claimed
+    UINT_64 limit;              // Most slots that may be claimed
+    UINT_8 pad[48];
+} sk_key_segment;
+
+/**
+ * Open addressing set of fixed size byte keys that any number of threads may insert into
+ *  and search at once without locking. Like sk_key_table, each slot keeps a 64-bit
+ *  fingerprint next to the key bytes; the high fingerprint bits select one of a fixed
+ *  number of segments and the low bits the home slot within it. A thread claims an
+ *  empty slot by compare-and-swap on its fingerprint, marked pending until the key bytes
+ *  are written. The set never grows: its segments are sized once for the expected keys.
+ */
+typedef struct sk_atomic_key_set
+{
+    UINT_64 key_size;           // Bytes per key
+    UINT_64 segment_capacity;   // Slots per segment, a power of two
+    UINT_64 capacity;           // Slots across every segment
+
+    sk_key_segment *segments;
+    _Atomic UINT_64 *fingerprints;  // 0 marks an empty slot
+    UINT_8 *keys;               // capacity * key_size bytes of key storage
+} sk_atomic_key_set;
+
+/**
+ * @brief                   Initializes an empty set sized to hold \c size_hint keys.
+ *
+ * @param[out] set          - Set to initialize
+ * @param[in] key_size      - Bytes per key
+ * @param[in] size_hint     - Most keys the set must hold
+ *
+ * @return                  true if the set storage was allocated.
+ */
+bool sk_atomic_key_set_init(sk_atomic_key_set *set, UINT_64 key_size, UINT_64 size_hint);
+
+/**
+ * @brief                   Stores \c key in \c set unless it is already present. Safe to call
+ *                              concurrently with any other insert or lookup.
+ *
+ * @param[in] set           - Set to insert into
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to store, copied into the set
+ *
+ * @return                  SK_KEY_SET_INSERTED if the key was absent and has been inserted,
+ *                              SK_KEY_SET_PRESENT if it was already there, SK_KEY_SET_FULL if
+ *                              it was absent and its segment has no room left.
+ */
+int sk_atomic_key_set_insert(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key);
+
+/**
+ * @brief                   Determines whether \c key is in \c set. Safe to call concurrently
+ *                              with any other insert or lookup.
+ *
+ * @param[in] set           - Set to search
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to look for
+ *
+ * @return                  true if the key is present.
+ */
+bool sk_atomic_key_set_contains(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key);
+
+/**
+ * @brief                   Number of keys stored in \c set.
+ *
+ * @param[in] set           - Set to count
+ *
+ * @return                  Number of keys.
+ */
+UINT_64 sk_atomic_key_set_count(sk_atomic_key_set *set);
+
+/**
+ * @brief                   Frees the storage of \c set. No thread may be using it.
+ *
+ * @param[in] set           - Set to destroy
+ */
+void sk_atomic_key_set_destroy(sk_atomic_key_set *set);
+
+#endif /* SK_ATOMIC_KEY_SET_H_ */
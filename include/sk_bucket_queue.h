@@ -0,0 +1,81 @@
+/*
+ * sk_bucket_queue.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_BUCKET_QUEUE_H_
+#define SK_BUCKET_QUEUE_H_
+
+// UINT_64, bool
+#include "sk_types/sk_types.h"
+
+/**
+ * One bucket of a bucket queue: a growable stack of elements sharing a priority.
+ */
+typedef struct sk_bucket
+{
+    void **items;
+    UINT_64 size;
+    UINT_64 capacity;
+} sk_bucket;
+
+/**
+ * Monotone priority queue over small non-negative integer priorities. Each priority owns a
+ *  bucket, so push and pop are O(1) apart from skipping empty buckets. The lowest priority
+ *  is popped first; elements of equal priority come out last in, first out.
+ */
+typedef struct sk_bucket_queue
+{
+    sk_bucket *buckets;
+    UINT_64 num_buckets;
+    UINT_64 min;                // No bucket below this one holds an element
+    UINT_64 size;               // Elements queued
+} sk_bucket_queue;
+
+/**
+ * @brief                   Initializes an empty queue.
+ *
+ * @param[out] queue        - Queue to initialize
+ */
+void sk_bucket_queue_init(sk_bucket_queue *queue);
+
+/**
+ * @brief                   Queues \c element with priority \c priority.
+ *
+ * @param[in] queue         - Queue to add to
+ * @param[in] priority      - Priority of \c element, lower is served first
+ * @param[in] element       - Element to queue
+ *
+ * @return                  true if the element was queued.
+ */
+bool sk_bucket_queue_push(sk_bucket_queue *queue, UINT_64 priority, void *element);
+
+/**
+ * @brief                   Removes the most recently queued element of the lowest priority.
+ *
+ * @param[in] queue         - Queue to take from
+ * @param[out] priority     - Priority of the element, may be NULL
+ *
+ * @return                  The element, or NULL if the queue is empty.
+ */
+void *sk_bucket_queue_pop(sk_bucket_queue *queue, UINT_64 *priority);
+
+/**
+ * @brief                   Determines whether \c queue holds no elements.
+ *
+ * @param[in] queue         - Queue to check
+ *
+ * @return                  true if the queue is empty.
+ */
+bool sk_bucket_queue_empty(const sk_bucket_queue *queue);
+
+/**
+ * @brief                   Frees the storage of \c queue. Queued elements are not freed.
+ *
+ * @param[in] queue         - Queue to destroy
+ */
+void sk_bucket_queue_destroy(sk_bucket_queue *queue);
+
+#endif /* SK_BUCKET_QUEUE_H_ */
@@ -0,0 +1,169 @@
+/*
+ * sk_key_table.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_KEY_TABLE_H_
+#define SK_KEY_TABLE_H_
+
+// UINT_64, UINT_8, bool
+#include "sk_types/sk_types.h"
+
+// FILE
+#include <stdio.h>
+
+/**
+ * Open addressing set of fixed size byte keys. Every slot keeps a 64-bit fingerprint of
+ *  its key next to the key bytes, so a probe only compares keys whose fingerprints match.
+ *  Fingerprints must be well mixed (e.g. Zobrist hashes): their low bits pick the home slot.
+ *  The table doubles whenever an insert would push it past its maximum load factor.
+ *  A table initialized with sk_key_table_init_map also stores a 64-bit value per key.
+ */
+typedef struct sk_key_table
+{
+    UINT_64 key_size;           // Bytes per key, may be 0 when the fingerprint is the whole key
+    UINT_64 capacity;           // Number of slots, always a power of two
+    UINT_64 count;              // Keys stored
+
+    UINT_64 *fingerprints;      // Slot fingerprints, 0 marks an empty slot
+    UINT_8 *keys;               // capacity * key_size bytes of key storage
+    UINT_64 *values;            // Value of each slot, NULL unless the table is a map
+
+    // Statistics
+    UINT_64 lookups;            // Calls to contains and insert
+    UINT_64 probes;             // Slots examined across every lookup
+    UINT_64 max_probe;          // Longest probe sequence seen
+    UINT_64 false_matches;      // Fingerprint matches whose keys differed
+    UINT_64 resizes;
+} sk_key_table;
+
+/**
+ * @brief                   Initializes an empty table sized to hold \c size_hint keys without growing.
+ *
+ * @param[out] table        - Table to initialize
+ * @param[in] key_size      - Bytes per key
+ * @param[in] size_hint     - Expected number of keys
+ *
+ * @return                  true if the table storage was allocated.
+ */
+bool sk_key_table_init(sk_key_table *table, UINT_64 key_size, UINT_64 size_hint);
+
+/**
+ * @brief                   Initializes an empty table that maps each key to a 64-bit value.
+ *
+ * @param[out] table        - Table to initialize
+ * @param[in] key_size      - Bytes per key
+ * @param[in] size_hint     - Expected number of keys
+ *
+ * @return                  true if the table storage was allocated.
+ */
+bool sk_key_table_init_map(sk_key_table *table, UINT_64 key_size, UINT_64 size_hint);
+
+/**
+ * @brief                   Determines whether \c key is stored in \c table.
+ *
+ * @param[in] table         - Table to search
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to look for
+ *
+ * @return                  true if the key is present.
+ */
+bool sk_key_table_contains(sk_key_table *table, UINT_64 fingerprint, const void *key);
+
+/**
+ * @brief                   Stores \c key in \c table unless it is already present.
+ *
+ * @param[in] table         - Table to insert into
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to store, copied into the table
+ *
+ * @return                  true if the key was absent and has been inserted.
+ */
+bool sk_key_table_insert(sk_key_table *table, UINT_64 fingerprint, const void *key);
+
+/**
+ * @brief                   Stores \c key with value \c value in map \c table unless the key
+ *                              is already present, in which case its value is left unchanged.
+ *
+ * @param[in] table         - Map to insert into
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to store, copied into the table
+ * @param[in] value         - Value to associate with \c key
+ *
+ * @return                  true if the key was absent and has been inserted.
+ */
+bool sk_key_table_put(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value);
+
+/**
+ * @brief                   Stores \c key with value \c value in map \c table, replacing the
+ *                              value of the key if it is already present.
+ *
+ * @param[in] table         - Map to store into
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to store, copied into the table
+ * @param[in] value         - Value to associate with \c key
+ *
+ * @return                  true if the value was stored.
+ */
+bool sk_key_table_set(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value);
+
+/**
+ * @brief                   Retrieves the value stored for \c key in map \c table.
+ *
+ * @param[in] table         - Map to search
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - key_size bytes to look for
+ * @param[out] value        - Value of the key, untouched if it is absent
+ *
+ * @return                  true if the key is present.
+ */
+bool sk_key_table_get(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 *value);
+
+/**
+ * @brief                   Writes the keys of \c table to \c out, without its empty slots.
+ *
+ * @param[in] table         - Table to write
+ * @param[in] out           - Stream to write to
+ *
+ * @return                  true if every key was written.
+ */
+bool sk_key_table_write(const sk_key_table *table, FILE *out);
+
+/**
+ * @brief                   Adds the keys written by sk_key_table_write to \c table.
+ *
+ * @param[in] table         - Initialized table or map of the written table's key size
+ * @param[in] in            - Stream to read from
+ *
+ * @return                  true if every key was read back.
+ */
+bool sk_key_table_read(sk_key_table *table, FILE *in);
+
+/**
+ * @brief                   Fraction of slots of \c table in use.
+ *
+ * @param[in] table         - Table to inspect
+ *
+ * @return                  Current load factor.
+ */
+double sk_key_table_load_factor(const sk_key_table *table);
+
+/**
+ * @brief                   Average number of slots examined per lookup so far.
+ *
+ * @param[in] table         - Table to inspect
+ *
+ * @return                  Mean probe length, 0 before the first lookup.
+ */
+double sk_key_table_mean_probe(const sk_key_table *table);
+
+/**
+ * @brief                   Frees the storage held by \c table.
+ *
+ * @param[in] table         - Table to destroy
+ */
+void sk_key_table_destroy(sk_key_table *table);
+
+#endif /* SK_KEY_TABLE_H_ */
@@ -0,0 +1,69 @@
+/*
+ * sk_mailbox.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_MAILBOX_H_
+#define SK_MAILBOX_H_
+
+// bool
+#include "sk_types/sk_types.h"
+
+// _Atomic, atomic_load, atomic_compare_exchange_weak, atomic_exchange
+#include <stdatomic.h>
+
+/**
+ * Link embedded at the start of every message posted to a mailbox. The mailbox never
+ *  allocates: messages are chained through their own links.
+ */
+typedef struct sk_mail
+{
+    struct sk_mail *next;
+} sk_mail;
+
+/**
+ * Lock-free mailbox with any number of senders and a single receiver. Senders push onto
+ *  a shared stack with compare-and-swap; the receiver detaches the whole stack at once.
+ */
+typedef struct sk_mailbox
+{
+    _Atomic(sk_mail *) head;    // Most recently posted message, NULL when empty
+} sk_mailbox;
+
+/**
+ * @brief                   Initializes an empty mailbox.
+ *
+ * @param[out] box          - Mailbox to initialize
+ */
+void sk_mailbox_init(sk_mailbox *box);
+
+/**
+ * @brief                   Posts \c mail to \c box. Safe to call from any thread.
+ *
+ * @param[in] box           - Mailbox to post to
+ * @param[in] mail          - Message to post, owned by the receiver from now on
+ */
+void sk_mailbox_post(sk_mailbox *box, sk_mail *mail);
+
+/**
+ * @brief                   Takes every message posted to \c box so far. Only the receiver
+ *                              may call this.
+ *
+ * @param[in] box           - Mailbox to empty
+ *
+ * @return                  The messages chained oldest first, or NULL if there were none.
+ */
+sk_mail *sk_mailbox_collect(sk_mailbox *box);
+
+/**
+ * @brief                   Determines whether \c box currently holds no messages.
+ *
+ * @param[in] box           - Mailbox to check
+ *
+ * @return                  true if the mailbox is empty.
+ */
+bool sk_mailbox_empty(sk_mailbox *box);
+
+#endif /* SK_MAILBOX_H_ */
@@ -0,0 +1,95 @@
+/*
+ * sk_record_file.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_RECORD_FILE_H_
+#define SK_RECORD_FILE_H_
+
+// UINT_64, UINT_8, bool
+#include "sk_types/sk_types.h"
+
+/**
+ * Buffered sequential reader or writer of fixed size records in a file. Every transfer
+ *  to or from the file is a whole buffer, so the file is only ever read and written in
+ *  large sequential blocks.
+ */
+typedef struct sk_record_stream
+{
+    int fd;
+    UINT_64 record_size;
+    UINT_8 *buffer;
+    UINT_64 capacity;           // Bytes in the buffer, a multiple of record_size
+    UINT_64 fill;               // Bytes of the buffer holding records
+    UINT_64 pos;                // Bytes of the buffer already handed out when reading
+    UINT_64 offset;             // File offset of the start of the buffer
+    bool writing;
+} sk_record_stream;
+
+/**
+ * @brief                   Creates an empty temporary file that is removed once closed.
+ *
+ * @param[in] dir           - Directory to create the file in
+ *
+ * @return                  File descriptor of the file, or -1 on failure.
+ */
+int sk_record_file_create(const char *dir);
+
+/**
+ * @brief                   Reads record \c index of a file written by a record stream.
+ *
+ * @param[in] fd            - File to read from
+ * @param[in] record_size   - Bytes per record
+ * @param[in] index         - Record to read
+ * @param[out] record       - Buffer of \c record_size bytes to fill
+ *
+ * @return                  true if the whole record was read.
+ */
+bool sk_record_file_read(int fd, UINT_64 record_size, UINT_64 index, void *record);
+
+/**
+ * @brief                   Opens a stream over \c fd from its first record.
+ *
+ * @param[out] stream       - Stream to initialize
+ * @param[in] fd            - File to read or write. The stream does not close it.
+ * @param[in] record_size   - Bytes per record
+ * @param[in] buffer_bytes  - Buffer size, rounded down to whole records but at least one
+ * @param[in] writing       - true to write records, false to read them
+ *
+ * @return                  true if the buffer was allocated.
+ */
+bool sk_record_stream_open(sk_record_stream *stream, int fd, UINT_64 record_size, UINT_64 buffer_bytes,
+                           bool writing);
+
+/**
+ * @brief                   Returns the next record of a reading stream. The record stays
+ *                              valid until the next call.
+ *
+ * @param[in] stream        - Stream to read from
+ *
+ * @return                  The record, or NULL at the end of the file or on error.
+ */
+const UINT_8 *sk_record_stream_read(sk_record_stream *stream);
+
+/**
+ * @brief                   Appends a record to a writing stream.
+ *
+ * @param[in] stream        - Stream to write to
+ * @param[in] record        - Record of record_size bytes
+ *
+ * @return                  true unless writing a full buffer to the file failed.
+ */
+bool sk_record_stream_write(sk_record_stream *stream, const void *record);
+
+/**
+ * @brief                   Writes out any buffered records and frees the buffer.
+ *
+ * @param[in] stream        - Stream to close
+ *
+ * @return                  true unless writing the last records failed.
+ */
+bool sk_record_stream_close(sk_record_stream *stream);
+
+#endif /* SK_RECORD_FILE_H_ */
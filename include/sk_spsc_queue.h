@@ -0,0 +1,67 @@
+/*
+ * sk_spsc_queue.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#ifndef SK_SPSC_QUEUE_H_
+#define SK_SPSC_QUEUE_H_
+
+// UINT_64, bool
+#include "sk_types/sk_types.h"
+
+// _Atomic
+#include <stdatomic.h>
+
+/**
+ * Bounded lock-free queue of pointers between exactly one producer thread and one consumer
+ *  thread. Each side only writes its own index, so neither ever waits on the other except
+ *  when the queue is full or empty.
+ */
+typedef struct sk_spsc_queue
+{
+    void **items;
+    UINT_64 capacity;           // A power of two
+    _Atomic UINT_64 head;       // Next item to take, written by the consumer only
+    UINT_8 pad[56];             // Keeps the two indices on separate cache lines
+    _Atomic UINT_64 tail;       // Next free slot, written by the producer only
+} sk_spsc_queue;
+
+/**
+ * @brief                   Initializes an empty queue holding up to \c capacity items.
+ *
+ * @param[out] queue        - Queue to initialize
+ * @param[in] capacity      - Most items queued at once, rounded up to a power of two
+ *
+ * @return                  true if the queue storage was allocated.
+ */
+bool sk_spsc_queue_init(sk_spsc_queue *queue, UINT_64 capacity);
+
+/**
+ * @brief                   Queues \c item. Only the producer may call this.
+ *
+ * @param[in] queue         - Queue to add to
+ * @param[in] item          - Item to queue
+ *
+ * @return                  true if the item was queued, false if the queue is full.
+ */
+bool sk_spsc_queue_push(sk_spsc_queue *queue, void *item);
+
+/**
+ * @brief                   Removes the oldest queued item. Only the consumer may call this.
+ *
+ * @param[in] queue         - Queue to take from
+ *
+ * @return                  The item, or NULL if the queue is empty.
+ */
+void *sk_spsc_queue_pop(sk_spsc_queue *queue);
+
+/**
+ * @brief                   Frees the storage of \c queue. Queued items are not freed.
+ *
+ * @param[in] queue         - Queue to destroy
+ */
+void sk_spsc_queue_destroy(sk_spsc_queue *queue);
+
+#endif /* SK_SPSC_QUEUE_H_ */
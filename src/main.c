@@ -28,6 +28,33 @@
 // gettimeofday, timeval
 #include <sys/time.h>
 
+// pthread_create, pthread_join, pthread_barrier_t
+#include <pthread.h>
+
+// sched_yield
+#include <sched.h>
+
+// uintptr_t
+#include <stdint.h>
+
+// atomic_fetch_add, atomic_load, atomic_compare_exchange_weak
+#include <stdatomic.h>
+
+// clock_gettime
+#include <time.h>
+
+// socketpair, send, recv
+#include <sys/socket.h>
+
+// mmap, munmap
+#include <sys/mman.h>
+
+// poll
+#include <poll.h>
+
+// waitpid
+#include <sys/wait.h>
+
 ///
 /// SK Library Includes
 ///
@@ -71,6 +98,27 @@
 // sk_hash_table, sk_hash_table_init, sk_hash_table_put, sk_hash_table_destroy, sk_hash_table_begin
 #include "sk_hash_table/sk_hash_table.h"
 
+// sk_key_table, sk_key_table_init, sk_key_table_insert, sk_key_table_destroy
+#include "sk_key_table.h"
+
+// sk_arena, sk_arena_init, sk_arena_alloc, sk_arena_destroy, sk_pool
+#include "sk_arena.h"
+
+// sk_bucket_queue, sk_bucket_queue_push, sk_bucket_queue_pop
+#include "sk_bucket_queue.h"
+
+// sk_mailbox, sk_mailbox_post, sk_mailbox_collect
+#include "sk_mailbox.h"
+
+// sk_atomic_key_set, sk_atomic_key_set_insert
+#include "sk_atomic_key_set.h"
+
+// sk_spsc_queue, sk_spsc_queue_push, sk_spsc_queue_pop
+#include "sk_spsc_queue.h"
+
+// sk_record_stream, sk_record_stream_read, sk_record_stream_write
+#include "sk_record_file.h"
+
 // sk_random
 #include "sk_random/sk_random.h"
 
@@ -87,6 +135,27 @@
 #define DEBUG_NONE          1
 
 
+struct pattern_database;
+typedef struct pattern_database pattern_database;
+
+struct pattern_set;
+typedef struct pattern_set pattern_set;
+
+struct pattern_file_entry;
+typedef struct pattern_file_entry pattern_file_entry;
+
+struct pattern_file_header;
+typedef struct pattern_file_header pattern_file_header;
+
+struct pattern_builder;
+typedef struct pattern_builder pattern_builder;
+
+struct checkpoint_writer;
+typedef struct checkpoint_writer checkpoint_writer;
+
+struct checkpoint_header;
+typedef struct checkpoint_header checkpoint_header;
+
 struct global_state;
 typedef struct global_state global_state;
 
@@ -96,9 +165,202 @@ typedef struct board_state board_state;
 enum direction;
 typedef enum direction direction;
 
+enum move_engine;
+typedef enum move_engine move_engine;
+
+struct bitboard;
+typedef struct bitboard bitboard;
+
+struct level_info;
+typedef struct level_info level_info;
+
 struct move;
 typedef struct move move;
 
+/// A move packed into 16 bits: the piece number above the two direction bits
+typedef UINT_16 packed_move;
+
+struct move_scan;
+typedef struct move_scan move_scan;
+
+struct search_path;
+typedef struct search_path search_path;
+
+struct breadth_frontier;
+typedef struct breadth_frontier breadth_frontier;
+
+struct transposition_table;
+typedef struct transposition_table transposition_table;
+
+struct goal_seeder;
+typedef struct goal_seeder goal_seeder;
+
+struct parallel_breadth;
+typedef struct parallel_breadth parallel_breadth;
+
+struct layer_worker;
+typedef struct layer_worker layer_worker;
+
+struct hda_node;
+typedef struct hda_node hda_node;
+
+struct hda_worker;
+typedef struct hda_worker hda_worker;
+
+struct hda_search;
+typedef struct hda_search hda_search;
+
+struct depth_entry;
+typedef struct depth_entry depth_entry;
+
+struct stealing_worker;
+typedef struct stealing_worker stealing_worker;
+
+struct stealing_search;
+typedef struct stealing_search stealing_search;
+
+struct set_bench_worker;
+typedef struct set_bench_worker set_bench_worker;
+
+struct pipeline_batch;
+typedef struct pipeline_batch pipeline_batch;
+
+struct pipeline_stage;
+typedef struct pipeline_stage pipeline_stage;
+
+struct pipeline_search;
+typedef struct pipeline_search pipeline_search;
+
+struct mp_buffer;
+typedef struct mp_buffer mp_buffer;
+
+struct mp_command;
+typedef struct mp_command mp_command;
+
+struct mp_report;
+typedef struct mp_report mp_report;
+
+struct mp_worker;
+typedef struct mp_worker mp_worker;
+
+struct external_search;
+typedef struct external_search external_search;
+
+enum direction
+{
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT
+};
+
+enum move_engine
+{
+    ENGINE_GRID,        // Scan the tile grid for every piece and direction
+    ENGINE_BITBOARD     // Shift-and-test per-piece occupancy masks
+};
+
+/**
+ * Static description of the loaded level, shared by every board state derived from it.
+ *  Pieces never change shape, so each piece belongs to a fixed shape class. A canonical
+ *  state key lists the anchor cell (first cell in row-major order) of every piece grouped
+ *  by class, followed by a bit per goal cell still uncovered. Two boards have equal keys
+ *  exactly when their normalized forms are equal. Keys are prefixed with the board's
+ *  Zobrist hash so that hashing a key costs nothing.
+ */
+struct level_info
+{
+    UINT_64 width;
+    UINT_64 height;
+
+    // Bounding box of all non-wall cells. Anchors are stored relative to it.
+    UINT_64 row_min;
+    UINT_64 col_min;
+    UINT_64 live_width;
+    UINT_64 live_height;
+    UINT_64 anchor_bytes;           // 1 or 2 bytes per stored anchor
+
+    SINT_64 max_piece;              // Largest piece number of the normalized start state, at least 3
+    UINT_64 num_pieces;             // Number of pieces, master included
+
+    UINT_64 num_classes;            // Class 0 is always the master piece
+    UINT_64 max_size;               // Cells in the largest piece
+    UINT_64 *class_size;            // Cells per piece of each class
+    SINT_64 *class_offsets;         // Cell offsets from the anchor, max_size per class
+    UINT_64 *class_start;           // First key slot of each class
+
+    UINT_64 num_goals;
+    UINT_64 *goals;                 // Cell numbers of every goal cell
+
+    UINT_64 key_size;               // Size in bytes of an encoded state key
+
+    // Zobrist keys, (num_classes + 1) per cell. Entry [cell][class] is toggled by a piece
+    //      of that class covering the cell, entry [cell][num_classes] by an uncovered goal.
+    UINT_64 *zobrist;
+};
+
+// Pieces of a pattern database, master included, and databases per file
+#define PDB_MAX_PIECES      8
+#define PDB_MAX_DATABASES   8
+
+/**
+ * Fewest moves to the goal from every placement of a few pieces on the level with every
+ *  other piece removed. The pieces form groups of one shape each, the master alone first.
+ *  A group's live anchors are ranked as a set, so placements that only swap pieces of one
+ *  shape share an entry. The first group's rank varies fastest. Points into a mapped
+ *  pattern file.
+ */
+struct pattern_database
+{
+    UINT_64 num_pieces;
+    SINT_64 pieces[PDB_MAX_PIECES]; // Grouped by shape, the master first
+    UINT_64 num_groups;
+    UINT_64 groups[PDB_MAX_PIECES]; // Pieces in each group
+    const UINT_8 *table;            // PDB_UNREACHED where no goal placement can be reached
+};
+
+/**
+ * Pattern databases loaded for the informed searches. Their estimates are combined by
+ *  taking the largest.
+ */
+struct pattern_set
+{
+    void *map;                      // Mapped pattern file, NULL when none is loaded
+    UINT_64 map_size;
+    UINT_64 *binomials;             // patternBinomials of the level
+    UINT_64 count;
+    pattern_database databases[PDB_MAX_DATABASES];
+};
+
+/**
+ * Periodic snapshots of a depth-first or breadth-first search. Each snapshot is written by
+ *  a forked copy of the process, which sees the search as it was at the fork while the
+ *  search itself carries on. A snapshot replaces the previous one only once complete.
+ */
+struct checkpoint_writer
+{
+    char *path;                     // Snapshot file, NULL when not taking snapshots
+    char *resume;                   // Snapshot to continue from, NULL to start afresh
+    FILE *input;                    // resume, opened and checked by main before the search starts
+    bool resume_failed;             // The search could not read its own state back from input
+    UINT_64 interval;               // Seconds between snapshots
+    UINT_64 polls;                  // Calls to checkpointDue, the clock is read every CHECKPOINT_POLL
+    struct timeval last;            // When the last snapshot was started
+    pid_t writer;                   // Process writing a snapshot, 0 when none
+    UINT_64 written;                // Snapshots completed
+    UINT_64 failed;                 // Snapshots whose writer failed
+    double longest_pause;           // Longest the search stood still to start a snapshot, in seconds
+};
+
+// Largest board supported by the bitboard engine is BITBOARD_WORDS * 64 cells
+#define BITBOARD_WORDS  16
+
+struct bitboard
+{
+    // Bit k is set when cell k (row-major) is occupied
+    UINT_64 bits[BITBOARD_WORDS];
+};
+
 struct global_state
 {
     printer_t *printer;
@@ -112,24 +374,60 @@ struct global_state
     UINT_64 N;
     bool depth_first;
     bool breadth_first;
+    bool iterative_deepening;
+    bool astar;
+    bool ida_star;
+    bool bidirectional;
+    UINT_64 parallel_threads;       // Workers of the parallel breadth first search, 0 when not selected
+    UINT_64 hda_threads;            // Workers of the hash distributed A*, 0 when not selected
+    UINT_64 stealing_threads;       // Workers of the work-stealing depth first search, 0 when not selected
+    UINT_64 closed_entries;         // Closed set capacity of the parallel searches, 0 for the default
+    UINT_64 set_bench_threads;      // Most threads of the atomic key set benchmark, 0 when not selected
+    bool pipelined;
+    UINT_64 mp_workers;             // Processes of the multi-process search, 0 when not selected
+    UINT_64 ext_memory;             // Memory cap in bytes of the external memory search, 0 when not selected
+    checkpoint_writer checkpoint;   // Snapshots of the depth first and breadth first searches
+    char *pdb_build_path;           // Pattern file to build, NULL when not selected
+    char *pdb_path;                 // Pattern file guiding the informed searches, NULL for none
+    pattern_set patterns;
+    bool scaling;                   // Repeat the parallel search at increasing thread counts
+    UINT_64 tt_entries;             // Transposition table size of the depth-bounded searches, 0 for none,
+                                    //      TT_ENTRIES_UNSET for the default of the search
+
+    move_engine engine;             // Move generation / application strategy
+    UINT_64 bitboard_words;         // Number of mask words spanned by the loaded board
+    bitboard board_cells;           // Every cell of the loaded board
+    bitboard edges[4];              // Cells a move in each direction would take off the board
 
     board_state *game_state;
+    level_info level;
 };
 
+/// Storage type of a single board cell. Wider than a byte so that piece numbers of
+///     large, not yet normalized boards are loaded intact.
+typedef SINT_16 tile_t;
+
 struct board_state
 {
     UINT_64 width;
     UINT_64 height;
 
-    SINT_64 **tiles;
-};
+    // Row-major cell buffer of width * height tiles, followed by the piece index
+    //      and, with the bitboard engine, the board's masks in the same allocation
+    tile_t *tiles;
 
-enum direction
-{
-    UP,
-    DOWN,
-    LEFT,
-    RIGHT
+    // Largest piece number covered by the piece index. Never less than 3.
+    SINT_64 max_piece;
+
+    // Piece index. The cells of piece p are piece_cells[piece_first[p]] up to
+    //      piece_cells[piece_first[p + 1] - 1], in row-major order. Built by
+    //      indexPieces and kept current by applyMove.
+    UINT_16 *piece_first;
+    UINT_16 *piece_cells;
+
+    // Zobrist hash of the piece layout. Independent of piece numbering, so it is
+    //      unaffected by normalization. Maintained incrementally by applyMove.
+    UINT_64 hash;
 };
 
 struct move
@@ -138,1848 +436,9013 @@ struct move
     direction dir;
 };
 
-#define GOAL    -1
-#define CLEAR    0
-#define WALL     1
-#define MASTER   2
-
-global_state state;
+/**
+ * Per-board state of an allocation-free move scan. Holds whatever the selected
+ *  engine precomputes once per board before testing individual moves.
+ */
+struct move_scan
+{
+    board_state *source;
 
+    // Bitboard engine: open cells of the board and the mask of the last piece examined
+    bitboard clear;
+    bitboard goal;
+    SINT_64 piece;
+    bitboard piece_mask;
+};
 
 /**
- * @brief                   Loads the game state from file with given filename
- *
- * @param[in] file_name     - Path to file to load.
- *
- * @return                  True if game state was successfully loaded.
+ * A single working board together with the moves that led to it from the search root.
+ *  Moves are applied and undone in place, so walking a search tree costs one board and
+ *  a packed move per level instead of a board per node. Goal cells are the only tiles a
+ *  move destroys, so the cells the master uncovers are logged to put them back on undo.
  */
-bool loadGameState(const char *file_name);
+struct search_path
+{
+    board_state board;              // Board reached by applying every path move to the root
+
+    UINT_64 size;                   // Number of moves applied
+    UINT_64 capacity;
+    packed_move *moves;             // Moves applied, root first
+    UINT_64 *goal_marks;            // Length of the goal log before each move was applied
+
+    UINT_64 *goal_log;              // Goal cells covered along the path, num_goals at most
+    UINT_64 goal_log_size;
+    UINT_64 goals_left;             // Goal cells of \c board still uncovered
+};
 
 /**
- * @brief                   Prints the global game state to the screen.
+ * Node store of a breadth-first search. Every node ever added keeps its parent index,
+ *  the move reaching it and its depth, each in its own array of fixed size chunks so that
+ *  entries never move. Only the nodes still waiting to be expanded hold a board: those
+ *  live in a ring of board slots that grows when the frontier outgrows it.
  */
-void outputGameState();
+struct breadth_frontier
+{
+    sk_arena arena;                 // Backing store of the node chunks
+    UINT_64 count;                  // Nodes added so far
+    UINT_64 head;                   // Next node to expand
+
+    UINT_64 chunk_capacity;         // Length of the chunk tables
+    UINT_64 **parents;              // Index of each node's parent, the root is its own parent
+    packed_move **moves;            // Move reaching each node from its parent
+    UINT_32 **depths;               // Number of moves from the root
+
+    board_state shape;              // Dimensions and piece count shared by every board
+    UINT_64 slot_tiles;             // Tiles per board slot
+    UINT_64 ring_capacity;          // Board slots, always a power of two
+    tile_t *ring;                   // Board of node i in slot i % ring_capacity
+    UINT_64 *ring_hash;             // Zobrist hash of the board in each slot
+};
 
 /**
- * @brief                   Clones game state \c source into \c dest.
- *
- * @param[in] source        - State to clone
- * @param[out] dest         - State to populate with clone
- *
- * @return                  true if clone succeeded.
+ * Fixed size table of states reached by a depth-bounded search, with the smallest depth
+ *  each was reached at during the current iteration. A state is stored in one of the
+ *  TT_PROBES entries following its hash. Entries of earlier
+ *  iterations are told apart by a stamp rather than cleared. On a collision the entry
+ *  reached at the shallower depth is kept, since it prunes the larger subtree. While
+ *  no state of an iteration is lost, the table also tells whether every state reached
+ *  was expanded, which means the whole reachable space was searched.
  */
-bool cloneGameState(board_state *source, board_state *dest);
+struct transposition_table
+{
+    UINT_64 capacity;               // Number of entries, a power of two, 0 when disabled
+    UINT_64 key_size;               // Bytes of state key stored per entry
+    UINT_64 *fingerprints;          // Zobrist hash of each entry's state, 0 when empty
+    UINT_32 *depths;
+    UINT_32 *stamps;                // Iteration each entry was written in
+    UINT_8 *keys;
+    bool *expanded;                 // Whether each entry's state was searched past this iteration
+    UINT_32 stamp;                  // Current iteration
+    UINT_64 slot;                   // Entry of the board last consulted, ~0 if it was not stored
+    UINT_64 dropped;                // States of this iteration evicted or never stored
+
+    // Statistics
+    UINT_64 cutoffs;                // Nodes pruned as already reached at no greater depth
+    UINT_64 stores;
+    UINT_64 replacements;           // Stores that evicted a different state of this iteration
+};
 
 /**
- * @brief                   Determines whether the current game state is solved.
- *
- * @param[in] source        - State to check
- *
- * @return                  true if board state is solved.
+ * State of the enumeration of solved boards seeding a backward search. Every piece but
+ *  the master is placed in turn, pieces of one class at increasing anchors so that no
+ *  arrangement is produced twice.
  */
-bool gameStateSolved(board_state *source);
+struct goal_seeder
+{
+    board_state board;              // Solved board under construction
+    UINT_64 num_labels;             // Pieces to place besides the master
+    SINT_64 *labels;                // Piece numbers, grouped by class
+    UINT_64 *classes;               // Class of each entry of \c labels
+    SINT_64 *rows;                  // Cell rows relative to the anchor, max_size per class
+    SINT_64 *cols;                  // Cell columns relative to the anchor, max_size per class
+
+    breadth_frontier *frontier;     // Receives every seed as a root
+    sk_key_table *seen;             // Maps seed keys to frontier indices
+    UINT_8 *key;
+    UINT_64 limit;                  // Most seeds accepted
+    bool overflow;                  // Set once more than \c limit seeds were found
+};
 
 /**
- * @brief                   Given a board state \c source and a piece \c piece, populates \c moves
- *                              with all possible moves for \c piece.
- *
- * @param[in] source        - Board state to check
- * @param[in] piece         - Piece to observe
- * @param[out] moves        - Pointer to list to construct and populate
+ * One thread of a level-synchronous breadth-first search. Each layer the worker expands
+ *  a contiguous share of the layer's nodes, recording every child it generates. It then
+ *  settles which of all the layer's children are new for its own shard of the closed
+ *  set, and finally builds the boards of the new children it generated.
  */
-void allMovesHelp(board_state *source, SINT_64 piece, sk_list *moves);
+struct layer_worker
+{
+    parallel_breadth *search;
+    UINT_64 id;
+    pthread_t thread;
+
+    board_state next;               // Scratch board for generated children
+    packed_move *moves;             // Moves possible in the node being expanded
+    UINT_8 *key;                    // Canonical key of \c next
+
+    // Children generated from this worker's share of the layer, in generation order
+    UINT_64 count;
+    UINT_64 capacity;
+    UINT_64 *parents;
+    packed_move *steps;
+    UINT_64 *hashes;
+    UINT_8 *keys;                   // Closed set keys, CLOSED_KEY_SIZE bytes per child
+    UINT_8 *fresh;                  // Set on children whose state was not reached before
+
+    UINT_64 solved;                 // First child solving the puzzle, ~0 for none
+    UINT_64 first_index;            // Frontier index given to the first fresh child
+};
 
 /**
- * @brief                   Given a board state \c source, populates \c moves with all
- *                                  possible moves.
- *
- * @param[in] source        - Board state to check
- * @param[out] moves        - Pointer to list to construct and populate
+ * Shared state of a level-synchronous breadth-first search. Workers meet at a barrier
+ *  between the phases of every layer. New nodes enter the frontier in the order the
+ *  sequential search would add them, whatever the number of workers.
  */
-void allMoves(board_state *source, sk_list *moves);
+struct parallel_breadth
+{
+    breadth_frontier frontier;
+    UINT_64 layer_end;              // End of the layer being expanded
+
+    UINT_64 num_threads;
+    layer_worker *workers;
+    sk_key_table *shards;           // Closed set, partitioned by hash, one shard per worker
+    pthread_barrier_t barrier;
+
+    bool done;                      // Set when the frontier runs out
+    bool found;                     // Set when a solution was generated
+    UINT_64 solved_parent;          // Node whose child solves the puzzle
+    packed_move solved_move;        // Move from \c solved_parent to the solution
+};
 
 /**
- * @brief                   Given a board state \c source, applies \c next_move to state in place.
- *
- * @param[in] source        - Board state to apply move to
- * @param[in] next_move     - Move to apply
+ * Search node of the hash distributed A*. The worker expanding a node creates its children
+ *  and posts each to the worker owning the child's hash, which keeps or frees it.
  */
-void applyMove(board_state *source, move next_move);
+struct hda_node
+{
+    sk_mail mail;                   // Mailbox link, must come first
+    board_state state;              // Tiles are released once the node has been expanded
+    hda_node *parent;               // NULL for the root
+    hda_node *owned;                // Next node kept by the same worker
+    packed_move last_move;
+    UINT_32 depth;
+    bool superseded;                // Set once the state is reached by a shorter path
+};
 
 /**
- * @brief                   Given a board state \c source, applies \c next move to
- *                              a clone of \c source, storing new state into \c dest.
- *
- * @param[in] source        - State to apply move to
- * @param[in] next_move     - Move to apply
- * @param[out] dest         - State to populate with cloned new state
+ * One thread of the hash distributed A*, owning the states whose hash maps to it. Only
+ *  the owner touches its open list and closed map; other workers reach it by mail.
  */
-void applyMoveCloning(board_state *source, move next_move, board_state *dest);
+struct hda_worker
+{
+    hda_search *search;
+    UINT_64 id;
+    pthread_t thread;
+
+    sk_mailbox inbox;               // Nodes posted by the other workers
+    sk_bucket_queue open;           // Nodes kept, by estimated solution length
+    sk_key_table closed;            // Maps each state key to its best node
+    hda_node *owned;                // Every node kept, chained for freeing
+
+    UINT_8 *key;
+    packed_move *moves;
+    bool busy;                      // Counted in the search's outstanding work
+    hda_node *best;                 // Shortest solved node kept, NULL for none
+    UINT_64 expanded;
+};
 
 /**
- * @brief                   Determines whether state \c a is exactly equal to state \c b
- *                              NOTE - a and b passed as const void pointers in order to conform
- *                              to signature expected by hash table data structure.
- *
- * @param[in] a             - State to compare
- * @param[in] b             - State to compare to
- *
- * @return                  true if both states are exactly equal.
+ * Shared state of the hash distributed A*. The search is over once no worker holds a node
+ *  that could improve on the best solution and no message is in transit. Both count
+ *  toward \c outstanding, which can thus only rise while it is non-zero.
  */
-bool stateEqual(const void *a, const void *b);
+struct hda_search
+{
+    UINT_64 num_threads;
+    hda_worker *workers;
+    _Atomic UINT_64 outstanding;    // Busy workers plus messages posted but not yet received
+    _Atomic UINT_64 incumbent;      // Length of the best solution found, ~0 for none
+};
 
 /**
- * @brief                   Given board state \c source, refactors state internals into
- *                              equivalent normal form.
- *
- * @param[in] source        - State to refactor
+ * A node waiting on a depth-first open stack: the move reaching it from its parent, which
+ *  is always the node at depth - 1 of the working path when the entry is popped.
  */
-void normalizeState(board_state *source);
+struct depth_entry
+{
+    packed_move next_move;
+    UINT_32 depth;
+};
 
-void destroy_board_state(void *p);
+/**
+ * One thread of the work-stealing depth-first search. Each worker walks its own path with
+ *  its own open stack, taken from the top. A worker that runs dry asks another for work;
+ *  the asked worker hands over the bottom, shallowest, entry of its stack together with
+ *  the moves leading to that entry's parent.
+ */
+struct stealing_worker
+{
+    stealing_search *search;
+    UINT_64 id;
+    pthread_t thread;
+
+    search_path path;
+    depth_entry *open;              // Pending nodes from open_base up to open_size
+    UINT_64 open_base;
+    UINT_64 open_size;
+    UINT_64 open_capacity;
+    UINT_8 *key;
+    packed_move *moves;
+
+    _Atomic SINT_64 request;        // Id of a worker asking this one for work, -1 for none
+    _Atomic int response;           // Answer to this worker's own request, a STEAL_ value
+    depth_entry loot;               // Entry handed over to this worker
+    packed_move *loot_path;         // Moves from the root to the parent of \c loot
+    UINT_64 loot_capacity;
+
+    UINT_64 nodes;
+    UINT_64 steals;                 // Entries taken from other workers
+};
 
-UINT_64 hashBoardState(const void *element, UINT_64 size);
+/**
+ * Shared state of the work-stealing depth-first search. Only a busy worker can hand out
+ *  work and it marks the receiving worker busy before doing so, so once every worker is
+ *  idle the search is exhausted.
+ */
+struct stealing_search
+{
+    UINT_64 num_threads;
+    stealing_worker *workers;
+    sk_atomic_key_set closed;
+    _Atomic UINT_64 idle;           // Workers without work
+    _Atomic bool stop;              // Set once a solution is reached, a node has no moves
+                                    //      or the closed set fills
+    bool found;                     // A solution was reached first
+    bool stuck;                     // A node without moves was reached first
+    UINT_64 winner;                 // Worker whose path is the solution
+};
 
 /**
- * @brief                   Applies up to \c N random moves to \c source, halting if the
- *                              board is solved after any move.
- *
- * @param[in] source        - Starting board state
- * @param[in] N             - Maximum number of moves to apply.
+ * One thread of the atomic key set benchmark. Every thread inserts every key of the run
+ *  once, each starting at its own offset, so that threads race on fresh and repeated keys.
  */
-void randomWalks(board_state *source, UINT_64 N);
+struct set_bench_worker
+{
+    sk_atomic_key_set *set;
+    UINT_64 id;
+    UINT_64 threads;
+    UINT_64 keys;                   // Distinct keys of the run, a power of two
+    UINT_64 key_size;
+    pthread_t thread;
+    pthread_barrier_t *start;       // Releases every thread at once
+
+    UINT_64 inserted;               // Inserts that reported a new key
+    UINT_64 full;                   // Inserts that found no room
+};
 
 /**
- * @brief                   Searches for a solution to the given board state using a depth-first strategy.
- *
- * @param[in] source        - Board state to solve
- * @param[in] closed        - hash table of board states already considered
- * @param[in] open          - List of board states on the frontier
- * @param[out] soln         - List to populate with solution moves
- * @param[out] nodes_visited- Number of nodes visited in the search
- *
- * @return                  true if the sequence of moves up to this point leads to a solution.
- *                              If a solution is found, the sequence of moves leading to solution will be stored in \c soln.
+ * Successors of a run of frontier nodes, passed whole between the stages of a pipelined
+ *  breadth-first search. The generating stage fills in the parents, moves, boards and
+ *  hashes, the encoding stage the keys and the detecting stage the fresh flags.
  */
-bool uninformedDepthFirst(board_state *source, sk_hash_table *closed, sk_list *open, sk_list *soln, UINT_64 *nodes_visited);
+struct pipeline_batch
+{
+    UINT_64 count;
+    UINT_64 *parents;
+    packed_move *moves;
+    UINT_64 *hashes;
+    tile_t *boards;                 // slot_tiles tiles per successor
+    UINT_8 *keys;                   // Closed set keys, CLOSED_KEY_SIZE bytes per successor
+    bool *fresh;                    // Set on successors whose state was not reached before
+};
 
 /**
- * @brief                   Searches for a solution to the given board state using a breadth-first strategy.
- *
- * @param[in] source        - Board state to solve
- * @param[out] closed       - hash table of board states traversed
- * @param[in] open          - Instantiated list of states to populate with the frontier
- * @param[out] soln         - List to populate with solution moves
- * @param[out] nodes_visited- Number of nodes visited in the search
- *
- * @return                  true if the sequence of moves up to this point leads to a solution.
- *                              If a solution is found, the sequence of moves leading to solution will be stored in \c soln.
+ * A thread of a pipelined breadth-first search, applying \c process to every batch that
+ *  arrives on \c input before passing it on to \c output.
  */
-bool uninformedBreadthFirst(board_state *source, sk_hash_table *closed, sk_list *open, sk_list *soln, UINT_64 *nodes_visited);
+struct pipeline_stage
+{
+    pipeline_search *search;
+    const char *name;
+    pthread_t thread;
+    void (*process)(pipeline_search *search, pipeline_batch *batch);
+    sk_spsc_queue *input;
+    sk_spsc_queue *output;
+
+    UINT_64 batches;                // Batches processed
+    double busy;                    // Seconds spent processing them
+};
 
 /**
- * @brief                       Debugging print function.
- *                                  Prints output to standard error if debug level is high enough.
- *
- * @param[in] out               - Printer structure containing open file descriptors
- * @param[in] level             - the level of detail of the message
- * @param[in] fmt               - Format string to pass to printf
- * @param[in] va_args           - Replacement pointers to pass to printf
+ * Shared state of a pipelined breadth-first search. Batches circulate from the generating
+ *  stage, which owns the frontier, through the encoding and detecting stages and back.
+ *  Queues keep their order, so nodes enter the frontier as in uninformedBreadthFirst.
  */
-void app_debug(printer_t *out, int level, char *fmt, ...);
+struct pipeline_search
+{
+    breadth_frontier frontier;
+    sk_key_table closed;            // Touched by the detecting stage only
+    UINT_64 batch_capacity;         // Successors per batch
+    UINT_64 key_size;
+
+    UINT_64 num_batches;
+    pipeline_batch *batches;
+    sk_spsc_queue queues[3];        // To encoding, to detecting, back to generating
+    pipeline_stage stages[3];       // Generating, encoding, detecting
+    _Atomic bool done;
+};
 
 /**
- * @brief                       Keyword "f" handler.
- *                                  Arguments: 1
- *                                  args[1] :
- *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * Bytes sent to or received from one socket. A message starts with its total length in
+ *  its first 8 bytes.
  */
-void handle_f(sk_str *match, sk_str **args, void *handle);
+struct mp_buffer
+{
+    UINT_8 *data;
+    UINT_64 size;
+    UINT_64 capacity;
+    UINT_64 sent;
+};
 
 /**
- * @brief                       Keyword "r" handler.
- *                                  Arguments: 1
- *                                  args[1] :
+ * Instruction from the coordinator of a multi-process search to a worker.
+ */
+struct mp_command
+{
+    UINT_64 type;                   // MP_EXPAND, MP_LOOKUP or MP_STOP
+    UINT_64 value;                  // Node index looked up
+};
+
+/**
+ * Reply of a multi-process search worker. After a layer, \c fresh counts the states it
+ *  took ownership of, and \c parent and \c step give the solving move if \c found. After a
+ *  lookup, \c parent and \c step describe the node looked up.
+ */
+struct mp_report
+{
+    UINT_64 fresh;
+    UINT_64 found;
+    UINT_64 parent;
+    UINT_64 step;
+};
+
+/**
+ * A worker process of a multi-process breadth-first search. It owns the states whose hash
+ *  maps to it: their closed set entries, the boards of those in the current layer, and
+ *  the parent and move of every one, for the coordinator to walk back a solution.
+ */
+struct mp_worker
+{
+    UINT_64 id;
+    UINT_64 num_workers;
+    int control;                    // Socket to the coordinator
+    int *peers;                     // Socket to each other worker, -1 for itself
+
+    board_state shape;              // Board every state is a layout of
+    board_state parent;             // Node being expanded, a view into the layer
+    board_state child;              // Successor being built or absorbed
+    UINT_64 slot_tiles;
+    UINT_64 record_size;            // Bytes describing one successor sent between workers
+    sk_key_table closed;
+    UINT_8 *key;
+    packed_move *moves;
+
+    UINT_64 count;                  // States owned so far
+    UINT_64 capacity;
+    UINT_64 *parents;               // MP_REF of each state's parent, MP_ROOT for the root
+    packed_move *steps;
+
+    UINT_64 layer_start;            // Index of the first state of the current layer
+    UINT_64 layer_count;
+    UINT_64 layer_capacity;
+    tile_t *layer;
+    UINT_64 *layer_hash;
+    UINT_64 next_count;
+    UINT_64 next_capacity;
+    tile_t *next;
+    UINT_64 *next_hash;
+
+    mp_buffer *out;                 // Successors for each worker, this one's included
+    mp_buffer *in;                  // Successors from each other worker
+};
+
+/**
+ * State of an external memory breadth-first search. Every depth layer is a file of
+ *  records sorted by state key: the key, the index of the parent in the layer above, the
+ *  move made from it and the board. Successors are sorted into runs in memory, and the
+ *  runs merged into the next layer without the states of the two layers before it.
+ */
+struct external_search
+{
+    UINT_64 memory;                 // Bytes of buffers the search may hold at once
+    UINT_64 io_buffer;              // Buffer of the layer reader and the run writer
+    const char *dir;                // Directory of the temporary files
+    UINT_64 key_size;
+    UINT_64 slot_tiles;
+    UINT_64 record_size;
+
+    UINT_64 num_layers;
+    UINT_64 layer_capacity;
+    int *layers;
+    UINT_64 *layer_count;
+
+    UINT_64 sort_capacity;          // Records the sort buffer holds
+    UINT_64 sort_count;
+    UINT_8 *sort_buffer;
+    UINT_8 **sort_order;
+
+    UINT_64 num_runs;               // Sorted runs of the layer being generated
+    UINT_64 run_capacity;
+    int *runs;
+
+    UINT_64 total_runs;
+    UINT_64 bytes_written;
+};
+
+/**
+ * Start of a search snapshot, followed by the closed set, the search's own state and
+ *  CHECKPOINT_END.
+ *  Snapshots are only read back by the same build on the same board, with the same
+ *  Zobrist keys: stored hashes and key orders depend on them.
+ */
+struct checkpoint_header
+{
+    char magic[8];                  // CHECKPOINT_MAGIC
+    UINT_64 mode;                   // CHECKPOINT_DEPTH or CHECKPOINT_BREADTH
+    UINT_64 zobrist_sum;            // zobristChecksum of the level
+    UINT_64 source_hash;            // Zobrist hash of the board searched from
+    UINT_64 key_size;
+    UINT_64 slot_tiles;
+    UINT_64 nodes_visited;
+};
+
+/**
+ * Description of one database of a pattern file. Its table lives at \c offset in the file.
+ */
+struct pattern_file_entry
+{
+    UINT_64 num_pieces;
+    SINT_64 pieces[PDB_MAX_PIECES];
+    UINT_64 num_groups;
+    UINT_64 groups[PDB_MAX_PIECES];
+    UINT_64 shapes[PDB_MAX_PIECES]; // pieceShapeHash of each piece
+    UINT_64 offset;
+    UINT_64 entries;
+};
+
+/**
+ * Start of a pattern file. The tables follow, each at a multiple of PDB_ALIGN, so that a
+ *  mapped file is used as is.
+ */
+struct pattern_file_header
+{
+    char magic[8];                  // PDB_MAGIC
+    UINT_64 layout;                 // levelLayoutHash of the level the file was built for
+    UINT_64 live_cells;             // Anchor positions of each piece
+    UINT_64 count;
+    pattern_file_entry databases[PDB_MAX_DATABASES];
+};
+
+/**
+ * Scratch state of a pattern database build: the level's fixed cells, the shape of each
+ *  pattern piece and the placement being examined.
+ */
+struct pattern_builder
+{
+    board_state *source;
+    const pattern_database *pattern;
+    UINT_64 sizes[PDB_MAX_PIECES];
+    SINT_64 *rows;                  // Row offset of each cell from the piece's anchor, max_size per piece
+    SINT_64 *cols;                  // Column offsets likewise
+    UINT_8 *grid;                   // PDB_FREE, PDB_WALL or PDB_GOAL for every cell
+    UINT_8 *occupied;               // 1 + position in the pattern of the piece covering each cell, or 0
+};
+
+// Answers to a steal request
+#define STEAL_WAITING   0
+#define STEAL_DENIED    1
+#define STEAL_GRANTED   2
+
+#define PACK_MOVE(piece, dir)   ((packed_move)(((piece) << 2) | (dir)))
+#define MOVE_PIECE(m)           ((SINT_64)((m) >> 2))
+#define MOVE_DIR(m)             ((direction)((m) & 0x3))
+
+// Largest piece number a packed move can hold
+#define MAX_PACKED_PIECE        ((1 << 14) - 1)
+
+// Direction undoing a move in direction \c dir. Relies on the UP, DOWN, LEFT, RIGHT order.
+#define OPPOSITE_DIR(dir)       ((direction)((dir) ^ 1))
+
+// Move undoing packed move \c m
+#define INVERSE_MOVE(m)         ((packed_move)((m) ^ 1))
+
+// Size of a move buffer able to hold every move of board \c board
+#define MOVE_CAPACITY(board)    (4 * ((board)->max_piece - 1))
+
+#define GOAL    -1
+#define CLEAR    0
+#define WALL     1
+#define MASTER   2
+
+// Largest piece number normalizeState relabels without a heap allocated remap table
+#define NORMALIZE_LOCAL_PIECES  256
+
+// Accesses the cell at row \c i, column \c j of board \c board
+#define TILE(board, i, j)   ((board)->tiles[(i) * (board)->width + (j)])
+
+// Number of cells held by board \c board
+#define CELLS(board)        ((board)->width * (board)->height)
+
+// Number of cells covered by piece \c p of board \c board
+#define PIECE_SIZE(board, p)    ((UINT_64)((board)->piece_first[(p) + 1] - (board)->piece_first[p]))
+
+// Cell numbers covered by piece \c p of board \c board
+#define PIECE_CELLS(board, p)   (&(board)->piece_cells[(board)->piece_first[p]])
+
+// Tiles taken by the masks the bitboard engine keeps with every board: clear cells, then
+//      uncovered goal cells. None with the grid engine.
+#define BOARD_MASK_TILES    (2 * state.bitboard_words * (sizeof(UINT_64) / sizeof(tile_t)))
+
+// Masks of board \c board, after its piece index. Not aligned for direct access.
+#define BOARD_MASKS(board)  ((board)->piece_cells + (board)->piece_first[(board)->max_piece + 1])
+
+// Length in tiles of the single allocation backing board \c board
+#define BOARD_BUFFER_SIZE(board) \
+    (CELLS(board) + (board)->max_piece + 2 + (board)->piece_first[(board)->max_piece + 1] + BOARD_MASK_TILES)
+
+// Largest board, in cells, that the piece index can address
+#define MAX_BOARD_CELLS     65535
+
+// Shape classes encodeStateKey tracks without a heap allocated table
+#define KEY_LOCAL_CLASSES   64
+
+// Zobrist key of a piece of class \c c covering cell \c cell
+#define ZOBRIST(level, cell, c)     ((level)->zobrist[(cell) * ((level)->num_classes + 1) + (c)])
+
+// Zobrist key of goal cell \c cell while it is uncovered
+#define ZOBRIST_GOAL(level, cell)   ZOBRIST(level, cell, (level)->num_classes)
+
+// Bytes of the Zobrist hash leading every encoded state key
+#define KEY_HASH_BYTES      sizeof(UINT_64)
+
+// Bytes of a state key stored in a closed set. The leading hash is kept as the slot fingerprint.
+#define CLOSED_KEY_SIZE(level)  ((level)->key_size - KEY_HASH_BYTES)
+
+// Most solved boards enumerated to seed the backward half of a bidirectional search
+#define GOAL_SEED_LIMIT     (1UL << 18)
+
+// Shard of the parallel closed set owning a hash. Uses the high bits, the low ones index the shard.
+#define CLOSED_SHARD(hash, shards)  ((UINT_64)((((hash) >> 32) * (shards)) >> 32))
+
+// Closed set capacity of the parallel searches when no size is configured
+#define PARALLEL_CLOSED_ENTRIES (1UL << 22)
+
+// Successors per batch of the pipelined search, and batches in circulation
+#define PIPELINE_BATCH      256
+#define PIPELINE_BATCHES    16
+
+// Commands from the coordinator of a multi-process search
+#define MP_EXPAND   0
+#define MP_LOOKUP   1
+#define MP_STOP     2
+
+// Reference to a state of a multi-process search: owning worker and index within it
+#define MP_REF(worker, index)   (((UINT_64)(worker) << 40) | (index))
+#define MP_REF_WORKER(ref)      ((ref) >> 40)
+#define MP_REF_INDEX(ref)       ((ref) & ((1UL << 40) - 1))
+#define MP_ROOT                 UINT64_MAX
+
+// Largest buffer of each record stream of the external memory search, the largest transfer made
+#define EXT_IO_BUFFER       (1UL << 20)
+
+// Parent index of the root record of the external memory search
+#define EXT_ROOT            UINT64_MAX
+
+// Searches a snapshot can be taken of
+#define CHECKPOINT_DEPTH    1
+#define CHECKPOINT_BREADTH  2
+
+#define CHECKPOINT_MAGIC    "SBPSNAP2"
+// Written last, so a snapshot cut short is caught before any of it is used
+#define CHECKPOINT_END      "SBPSEND1"
+
+// Default seconds between snapshots, and calls to checkpointDue between clock reads
+#define CHECKPOINT_INTERVAL 300
+#define CHECKPOINT_POLL     4096
+
+#define PDB_MAGIC           "SBPPDB01"
+
+// Largest table of a pattern database, in entries, and the alignment of tables in a file
+#define PDB_MAX_ENTRIES     (1UL << 24)
+#define PDB_ALIGN           64
+
+// Table entry of placements that cannot reach the goal. Distances are capped just below it.
+#define PDB_UNREACHED       255
+
+// Cells of a pattern database build
+#define PDB_FREE            0
+#define PDB_WALL            1
+#define PDB_GOAL            2
+
+// Ways to choose k of n live cells, saturated above PDB_MAX_ENTRIES
+#define PDB_BINOMIAL(binomials, n, k)   ((binomials)[(n) * (PDB_MAX_PIECES + 1) + (k)])
+
+// Distinct keys inserted by the atomic key set benchmark, and the odd stride each thread
+//      walks them by
+#define SET_BENCH_KEYS      (1UL << 19)
+#define SET_BENCH_STRIDE    0x9E3779B1UL
+
+// Transposition table entries of the depth-bounded searches when no size is configured
+#define DEPTH_TT_ENTRIES    (1UL << 20)
+
+// Consecutive transposition table entries a state may be stored in
+#define TT_PROBES           4
+
+// Whether transposition table entry i holds a state of the current iteration
+#define TRANSPOSITION_CURRENT(table, i) \
+    ((table)->fingerprints[i] && (table)->stamps[i] == (table)->stamp)
+
+// Transposition table size before any -tt, so that -tt 0 can switch the table off
+#define TT_ENTRIES_UNSET    (~0UL)
+
+// Initial number of states a search's closed set is sized for
+#define CLOSED_SIZE_HINT    100000
+
+// Bytes per chunk of the arena holding a search's nodes and boards
+#define SEARCH_ARENA_CHUNK  (1 << 20)
+
+// Breadth-first nodes per chunk of each node array, as a power of two
+#define FRONTIER_CHUNK_BITS 12
+#define FRONTIER_CHUNK      (1UL << FRONTIER_CHUNK_BITS)
+
+// Accesses field \c field of node \c i of breadth-first frontier \c f
+#define FRONTIER_NODE(f, field, i)  ((f)->field[(i) >> FRONTIER_CHUNK_BITS][(i) & (FRONTIER_CHUNK - 1)])
+
+global_state state;
+
+
+/**
+ * @brief                   Loads the game state from file with given filename
  *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * @param[in] file_name     - Path to file to load.
+ *
+ * @return                  True if game state was successfully loaded.
  */
-void handle_r(sk_str *match, sk_str **args, void *handle);
+bool loadGameState(const char *file_name);
 
 /**
- * @brief                       Keyword "d" handler.
- *                                  Arguments: 1
- *                                  args[1] :
+ * @brief                   (Re)builds the piece index of \c source from its tiles,
+ *                              resizing the state's single allocation to fit.
  *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * @param[in] source        - State to index
+ *
+ * @return                  true if the index was built.
  */
-void handle_d(sk_str *match, sk_str **args, void *handle);
+bool indexPieces(board_state *source);
 
 /**
- * @brief                       Keyword "b" handler.
- *                                  Arguments: 1
- *                                  args[1] :
+ * @brief                   Prints the global game state to the screen.
+ */
+void outputGameState();
+
+/**
+ * @brief                   Clones game state \c source into \c dest.
  *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * @param[in] source        - State to clone
+ * @param[out] dest         - State to populate with clone
+ *
+ * @return                  true if clone succeeded.
  */
-void handle_b(sk_str *match, sk_str **args, void *handle);
+bool cloneGameState(board_state *source, board_state *dest);
 
 /**
- * @brief                       Keyword "verbose" handler.
- *                                  Arguments: 0
- *                                  Raises the debug level of the program to maximum.
+ * @brief                   Clones game state \c source into \c dest, storing the tiles and
+ *                              piece index in caller owned memory rather than a fresh allocation.
+ *                              \c dest must not be passed to destroy_board_state.
  *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * @param[in] source        - State to clone
+ * @param[out] dest         - State to populate with clone
+ * @param[in] buffer        - Storage for BOARD_BUFFER_SIZE(source) tiles
+ *
+ * @return                  true if clone succeeded.
  */
-void handle_verbose(sk_str *match, sk_str **args, void *handle);
+bool cloneGameStateInto(board_state *source, board_state *dest, tile_t *buffer);
 
 /**
- * @brief                       Keyword miss handler.
- *                                  Handles arguments not matching any registered keyword.
+ * @brief                   Determines whether the current game state is solved.
  *
- * @param[in] match             - Input argument string which matches registered keyword
- * @param[in] args              - Arguments following the keyword
- * @param[in] handle            - Handle to common state
+ * @param[in] source        - State to check
+ *
+ * @return                  true if board state is solved.
  */
-void handle_miss(sk_str *match, sk_str **args, void *handle);
+bool gameStateSolved(board_state *source);
 
 /**
- * @brief                       Parses the input argument array for configuration parameters.
+ * @brief                   Given a board state \c source and a piece \c piece, populates \c moves
+ *                              with all possible moves for \c piece.
  *
- * @param[in] state             - State to update with configuration
- * @param[in] argc              - Number of command line arguments
- * @param[in] argv              - Argument array
+ * @param[in] source        - Board state to check
+ * @param[in] piece         - Piece to observe
+ * @param[out] moves        - Pointer to list to construct and populate
+ */
+void allMovesHelp(board_state *source, SINT_64 piece, sk_list *moves);
+
+/**
+ * @brief                   Determines whether \c piece of \c source can move in direction
+ *                              \c dir, examining only the cells the piece covers.
  *
- * @return                      true if the argument vector was successfully processed.
+ * @param[in] source        - Board state to check
+ * @param[in] piece         - Piece to move
+ * @param[in] dir           - Direction of the move
+ *
+ * @return                  true if every destination cell is on the board and is clear, part
+ *                              of the piece itself, or a goal cell being entered by the master
+ *                              piece.
  */
-bool interpret_input_arguments(global_state *state, int argc, char **argv);
+bool pieceMoveLegal(board_state *source, SINT_64 piece, direction dir);
 
 /**
- * @brief                       Validates the global state against program assumptions.
+ * @brief                   Determines whether the neighbour of \c cell in direction \c dir
+ *                              lies on the board. Border cells need not be walls.
  *
- * @param[in] state             - State to check.
+ * @param[in] source        - Board state holding the cell
+ * @param[in] cell          - Cell to step from
+ * @param[in] dir           - Direction of the step
  *
- * @return                      true if the passed state is valid for program execution.
+ * @return                  true if the step stays within the board's rows and columns.
  */
-bool validate_global_state(global_state *state);
+bool cellStepOnBoard(const board_state *source, UINT_64 cell, direction dir);
 
 /**
- * @brief                       Performs memory cleanup on global state \c p.
+ * @brief                   Given a board state \c source, populates \c moves with all
+ *                                  possible moves.
  *
- * @param[in] p                 - Pointer to destroy
+ * @param[in] source        - Board state to check
+ * @param[out] moves        - Pointer to list to construct and populate
  */
-void destroy_global_state(void *p);
+void allMoves(board_state *source, sk_list *moves);
 
 /**
- * @brief                   Attempts to expand \c filename into an absolute path.
- *                              Checks for the existence of a file at that path.
+ * @brief                   Given a board state \c source, writes every possible move into the
+ *                              caller provided buffer \c moves without allocating.
+ *                              Moves are produced in the same order as \c allMoves.
  *
- * @param[in] filename      - a filename to search for.
- *                              Can either be an absolute path or a single filename.
- * @param[out] resolved     - a reference into which to store the absolute path to the found file.
+ * @param[in] source        - Board state to check
+ * @param[out] moves        - Buffer to populate. May be NULL if \c capacity is 0.
+ * @param[in] capacity      - Number of moves \c moves can hold
  *
- * @return                  true if a matching file was found
+ * @return                  The number of possible moves. Only the first \c capacity are stored.
  */
-bool resolve_input_file(const char *filename, sk_str **resolved);
+UINT_64 generateMoves(board_state *source, packed_move *moves, UINT_64 capacity);
 
 /**
- * @brief                   File existential query function.
+ * @brief                   Counts the possible moves of board state \c source.
  *
- * @param path              - a path to check for file existence over.
+ * @param[in] source        - Board state to check
  *
- * @returns                 true if a file exists that is represented by the given path
+ * @return                  The number of possible moves.
  */
-bool exists(sk_str *path);
+UINT_64 countMoves(board_state *source);
 
 /**
- * @brief                   Reliably reads \c n bytes from file \c fd into buffer \c dst.
+ * @brief                   Retrieves the move at position \c n of the move order of \c source.
  *
- * @param[in] fd            - file descriptor of file to read.
- * @param[out] dst          - destination buffer
- * @param[in] n             - number of bytes to read in
+ * @param[in] source        - Board state to check
+ * @param[in] n             - Zero based position of the move to retrieve
+ * @param[out] dest         - Move to populate
  *
- * @return                  the number of bytes successfully read.
- *                          -1 on error.
+ * @return                  true if \c source has more than \c n possible moves.
  */
-SINT_64 r_fread(int fd, void *dst, UINT_64 n);
+bool nthMove(board_state *source, UINT_64 n, packed_move *dest);
 
 /**
- * @brief                   Retrieves a string from the given file.
- *                              Input halts at newline, and skips over '\0' characters.
+ * @brief                   Expands packed move \c packed into a move structure.
  *
- * @param[out] s            - Destination buffer
- * @param[in] n             - Max number of characters to read in
- * @param[in] fd            - file descriptor of file to read
+ * @param[in] packed        - Move to expand
  *
- * @return                  The number of characters read.
+ * @return                  The expanded move.
  */
-UINT_64 _ngets(char *s, UINT_64 n, int fd);
+move unpackMove(packed_move packed);
 
 /**
- * @brief                   Retrieves a line from the given file.
+ * @brief                   Given a board state \c source, applies \c next_move to state in place.
  *
- * @param[in] fd            - File descriptor of file to read.
- * @param[out] dest         - Destination string.
+ * @param[in] source        - Board state to apply move to
+ * @param[in] next_move     - Move to apply
+ */
+void applyMove(board_state *source, move next_move);
+
+/**
+ * @brief                   Number of cells a piece travels when moving in direction \c dir.
  *
- * @return                  true if a line was able to be retrieved from the file.
+ * @param[in] source        - Board the piece is on
+ * @param[in] dir           - Direction of travel
+ *
+ * @return                  Signed cell offset of the move.
  */
-bool fd_get_line(int fd, sk_str *dest);
+SINT_64 directionOffset(const board_state *source, direction dir);
 
-int main (int argc, char **argv)
-{
-    printer_t *printer = Printer();
-    printer->debug = app_debug;
-    printer->debug_level = DEBUG_NONE;
+/**
+ * @brief                   Shifts mask \c src by \c shift cells into \c dest.
+ *                              Positive shifts move bits towards higher cell numbers.
+ *
+ * @param[in] src           - Mask to shift
+ * @param[in] shift         - Number of cells to shift by
+ * @param[out] dest         - Mask to populate. Must not alias \c src.
+ */
+void bitboardShift(const bitboard *src, SINT_64 shift, bitboard *dest);
 
-    sk_random_default_init(&state.random);
+/**
+ * @brief                   Determines whether the piece occupying \c piece_mask may move in
+ *                              direction \c dir, \c offset cells, using the open cell masks
+ *                              \c clear and \c goal.
+ *
+ * @return                  true if the piece stays on the board and every destination cell is
+ *                              clear, part of the piece itself, or a goal cell being entered by
+ *                              the master piece.
+ */
+bool bitboardMoveLegal(const bitboard *piece_mask, SINT_64 piece, direction dir, SINT_64 offset,
+                        const bitboard *clear, const bitboard *goal);
 
-    int retval = EXIT_SUCCESS;
+/**
+ * @brief                   Computes the board and edge masks of the bitboard engine for the
+ *                              dimensions of \c source.
+ *
+ * @param[in] source        - Board state of the loaded level
+ */
+void initBitboardMasks(board_state *source);
 
-    state.printer = printer;
-    state.input_file_path = "./assets/SBP-level0.txt";
-    state.resolved_path = NULL;
-    state.random_walk = false;
-    state.breadth_first = false;
-    state.depth_first = false;
-    state.game_state = NULL;
+/**
+ * @brief                   Copies out the clear and uncovered goal cell masks kept with
+ *                              \c source by the bitboard engine.
+ *
+ * @param[in] source        - Board state holding the masks
+ * @param[out] clear        - Mask of clear cells
+ * @param[out] goal         - Mask of uncovered goal cells
+ */
+void loadBoardMasks(const board_state *source, bitboard *clear, bitboard *goal);
 
+/**
+ * @brief                   Stores the clear and uncovered goal cell masks of \c source.
+ *
+ * @param[in] source        - Board state to hold the masks
+ * @param[in] clear         - Mask of clear cells
+ * @param[in] goal          - Mask of uncovered goal cells
+ */
+void storeBoardMasks(board_state *source, const bitboard *clear, const bitboard *goal);
 
-    // Step 0: Retrieve program configuration from command line
-    if (!interpret_input_arguments(&state, argc, argv))
-    {
-        state.printer->error(state.printer, "Failed to interpret input arguments. Aborting.\n");
-        retval = EXIT_FAILURE;
-        goto cleanup;
+/**
+ * @brief                   Marks \c cell of \c source as an uncovered goal cell again,
+ *                              keeping the hash and the bitboard engine's masks in step.
+ *
+ * @param[in] source        - Board state to update
+ * @param[in] cell          - Clear cell that is one of the level's goal cells
+ */
+void uncoverGoal(board_state *source, UINT_64 cell);
+
+/**
+ * @brief                   Bitboard engine equivalent of \c applyMove.
+ *                              Tests the shifted piece mask against the open cells, then
+ *                              moves the piece by clearing its mask and writing the shifted mask.
+ *
+ * @param[in] source        - Board state to apply move to
+ * @param[in] next_move     - Move to apply
+ */
+void applyMoveBitboard(board_state *source, move next_move);
+
+/**
+ * @brief                   Updates the Zobrist hash of \c source for a legal move of \c piece
+ *                              by \c offset cells. Must be called before the tiles are moved.
+ *
+ * @param[in] source        - Board state the move is applied to
+ * @param[in] piece         - Piece being moved
+ * @param[in] offset        - Signed cell offset of the move
+ */
+void zobristMove(board_state *source, SINT_64 piece, SINT_64 offset);
+
+/**
+ * @brief                   Given a board state \c source, applies \c next move to
+ *                              a clone of \c source, storing new state into \c dest.
+ *
+ * @param[in] source        - State to apply move to
+ * @param[in] next_move     - Move to apply
+ * @param[out] dest         - State to populate with cloned new state
+ */
+void applyMoveCloning(board_state *source, move next_move, board_state *dest);
+
+/**
+ * @brief                   Starts an empty search path at a copy of board \c source.
+ *
+ * @param[out] path         - Path to initialize
+ * @param[in] source        - Root board of the path
+ */
+void initSearchPath(search_path *path, board_state *source);
+
+/**
+ * @brief                   Applies legal move \c next to the working board of \c path
+ *                              and records it on the path.
+ *
+ * @param[in] path          - Path to extend
+ * @param[in] next          - Move to apply
+ */
+void pathApply(search_path *path, packed_move next);
+
+/**
+ * @brief                   Undoes the last move of \c path, restoring the working board
+ *                              exactly, hash and piece index included.
+ *
+ * @param[in] path          - Path to shorten
+ */
+void pathUndo(search_path *path);
+
+/**
+ * @brief                   Frees the memory held by search path \c p.
+ *
+ * @param[in] p             - Path to destroy
+ */
+void destroy_search_path(void *p);
+
+/**
+ * @brief                   Starts a breadth-first frontier holding only the root \c source.
+ *
+ * @param[out] frontier     - Frontier to initialize
+ * @param[in] source        - Root board
+ */
+void initBreadthFrontier(breadth_frontier *frontier, board_state *source);
+
+/**
+ * @brief                   Views the board slot of node \c i, which must not be expanded yet.
+ *
+ * @param[in] frontier      - Frontier holding the node
+ * @param[in] i             - Node index, up to and including \c frontier->count
+ * @param[out] dest         - Board header to point at the slot
+ */
+void frontierBoard(breadth_frontier *frontier, UINT_64 i, board_state *dest);
+
+/**
+ * @brief                   Makes room for one more node and views the board slot it will occupy.
+ *                              The node is only added by a following frontierCommit.
+ *
+ * @param[in] frontier      - Frontier to extend
+ * @param[out] dest         - Board header to point at the free slot
+ */
+void frontierReserve(breadth_frontier *frontier, board_state *dest);
+
+/**
+ * @brief                   Adds the node whose board was written to the reserved slot.
+ *
+ * @param[in] frontier      - Frontier to extend
+ * @param[in] board         - Board header returned by frontierReserve
+ * @param[in] parent        - Index of the expanded node, or frontier->count to add a root
+ * @param[in] next          - Move from \c parent to the new node
+ */
+void frontierCommit(breadth_frontier *frontier, board_state *board, UINT_64 parent, packed_move next);
+
+/**
+ * @brief                   Frees the memory held by breadth-first frontier \c p.
+ *
+ * @param[in] p             - Frontier to destroy
+ */
+void destroy_breadth_frontier(void *p);
+
+/**
+ * @brief                   Determines whether state \c a is exactly equal to state \c b
+ *                              NOTE - a and b passed as const void pointers in order to conform
+ *                              to signature expected by hash table data structure.
+ *
+ * @param[in] a             - State to compare
+ * @param[in] b             - State to compare to
+ *
+ * @return                  true if both states are exactly equal.
+ */
+bool stateEqual(const void *a, const void *b);
+
+/**
+ * @brief                   Given board state \c source, refactors state internals into
+ *                              equivalent normal form.
+ *
+ * @param[in] source        - State to refactor
+ */
+void normalizeState(board_state *source);
+
+void destroy_board_state(void *p);
+
+UINT_64 hashBoardState(const void *element, UINT_64 size);
+
+/**
+ * @brief                   Builds the static level description from the normalized starting
+ *                              board \c source: shape classes, anchor region, goal cells and key size.
+ *
+ * @param[in] source        - Normalized starting board state
+ * @param[out] level        - Level description to populate
+ *
+ * @return                  true if the level could be described.
+ */
+bool initLevelInfo(board_state *source, level_info *level);
+
+/**
+ * @brief                   Frees the contents of level description \c p.
+ *
+ * @param[in] p             - Pointer to destroy
+ */
+void destroy_level_info(void *p);
+
+/**
+ * @brief                   Computes the Zobrist hash of \c source from scratch.
+ *                              Used to seed the starting state; applyMove keeps it current afterwards.
+ *
+ * @param[in] source        - State to hash
+ *
+ * @return                  Zobrist hash of \c source.
+ */
+UINT_64 zobristHash(board_state *source);
+
+/**
+ * @brief                   Hashes every Zobrist key of the level. The keys come from
+ *                              sk_random_default_init, so a process is only known to share
+ *                              another's hashes, and with them its snapshots, if this matches.
+ *
+ * @param[in] source        - Board state of the level
+ *
+ * @return                  Hash of the Zobrist keys.
+ */
+UINT_64 zobristChecksum(board_state *source);
+
+/**
+ * @brief                   Determines the shape class of piece \c piece on board \c source.
+ *
+ * @param[in] source        - Board the piece is on
+ * @param[in] piece         - Piece to classify
+ *
+ * @return                  Shape class of \c piece.
+ */
+UINT_64 pieceClass(board_state *source, SINT_64 piece);
+
+/**
+ * @brief                   Encodes board state \c source into its canonical compact key.
+ *                              \c source need not be normalized.
+ *
+ * @param[in] source        - State to encode
+ * @param[out] key          - Buffer of at least \c state.level.key_size bytes
+ */
+void encodeStateKey(board_state *source, UINT_8 *key);
+
+/**
+ * @brief                   Prints solution \c soln, applying it to the global game state,
+ *                              followed by the search statistics. Frees the moves of \c soln.
+ *
+ * @param[in] soln          - Moves of the solution, in order
+ * @param[in] nodes         - Number of nodes visited by the search
+ * @param[in] start         - Time the search started
+ * @param[in] stop          - Time the search finished
+ */
+void printSolution(sk_list *soln, UINT_64 nodes, const struct timeval *start, const struct timeval *stop);
+
+/**
+ * @brief                   Prints the size and probe statistics of closed set \c closed
+ *                          as a debug message (shown with -verbose).
+ *
+ * @param[in] closed        - Closed set of a finished search
+ */
+void printClosedStats(const sk_key_table *closed);
+
+/**
+ * @brief                   Applies up to \c N random moves to \c source, halting if the
+ *                              board is solved after any move.
+ *
+ * @param[in] source        - Starting board state
+ * @param[in] N             - Maximum number of moves to apply.
+ */
+void randomWalks(board_state *source, UINT_64 N);
+
+/**
+ * @brief                   Searches for a solution to the given board state using a depth-first strategy.
+ *                              A single working board is walked down and back up the search
+ *                              tree in place; the open stack holds one move per pending node.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] closed        - Set of canonical keys of board states already considered
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes visited in the search
+ *
+ * @return                  true if the sequence of moves up to this point leads to a solution.
+ *                              If a solution is found, the sequence of moves leading to solution will be stored in \c soln.
+ */
+bool uninformedDepthFirst(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Searches for a solution to the given board state using a breadth-first strategy.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[out] closed       - Set of canonical keys of board states traversed
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes visited in the search
+ *
+ * @return                  true if the sequence of moves up to this point leads to a solution.
+ *                              If a solution is found, the sequence of moves leading to solution will be stored in \c soln.
+ */
+bool uninformedBreadthFirst(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Initializes transposition table \c table with room for \c entries
+ *                              states, rounded down to a power of two. No storage is
+ *                              allocated when \c entries is 0.
+ *
+ * @param[out] table        - Table to initialize
+ * @param[in] entries       - Requested number of entries
+ */
+void initTranspositionTable(transposition_table *table, UINT_64 entries);
+
+/**
+ * @brief                   Starts a new iteration of \c table: entries of earlier ones no
+ *                              longer cut off the search.
+ *
+ * @param[in] table         - Table to update
+ */
+void beginTranspositionIteration(transposition_table *table);
+
+/**
+ * @brief                   Records that the working board of \c path was reached at depth
+ *                              \c path->size, unless it was already reached no deeper during
+ *                              the current iteration.
+ *
+ * @param[in] table         - Table to consult and update
+ * @param[in] path          - Path whose working board was just reached
+ * @param[in] key           - Scratch buffer of at least \c state.level.key_size bytes
+ *
+ * @return                  true if the board needs no further search in this iteration.
+ */
+bool transpositionCutoff(transposition_table *table, search_path *path, UINT_8 *key);
+
+/**
+ * @brief                   Marks the board last passed to transpositionCutoff as searched
+ *                              past, its children all generated in this iteration.
+ *
+ * @param[in] table         - Table to update, may be NULL
+ */
+void transpositionExpand(transposition_table *table);
+
+/**
+ * @brief                   Whether the current iteration of \c table lost no state and
+ *                              searched past every state it reached. The states reached are
+ *                              then closed under moves: the whole reachable space.
+ *
+ * @param[in] table         - Table of a finished iteration, may be NULL
+ *
+ * @return                  true if every reachable state was searched.
+ */
+bool transpositionComplete(const transposition_table *table);
+
+/**
+ * @brief                   Prints the usage statistics of transposition table \c table.
+ *
+ * @param[in] table         - Table of a finished search
+ */
+void printTranspositionStats(const transposition_table *table);
+
+/**
+ * @brief                   Frees the memory held by transposition table \c p.
+ *
+ * @param[in] p             - Table to destroy
+ */
+void destroy_transposition_table(void *p);
+
+/**
+ * @brief                   Depth-first search of the working board of \c path, only entering
+ *                              nodes whose cost bound does not exceed \c bound. The cost bound
+ *                              of a node is its depth, plus goalEstimate if \c informed.
+ *
+ * @param[in] path          - Path at the node to search. Holds the solution on success.
+ * @param[in] bound         - Largest cost bound to consider
+ * @param[in] informed      - Whether to add the heuristic estimate to the depth
+ * @param[in] moves         - Move buffer of MOVE_CAPACITY moves per level up to \c bound
+ * @param[in] table         - Transposition table, may be NULL
+ * @param[in] key           - Scratch buffer of at least \c state.level.key_size bytes
+ * @param[out] nodes        - Incremented for every node visited
+ * @param[out] next_bound   - Lowered to the smallest cost bound that exceeded \c bound
+ *
+ * @return                  true if a solution was found.
+ */
+bool boundedSearch(search_path *path, UINT_64 bound, bool informed, packed_move *moves,
+                   transposition_table *table, UINT_8 *key, UINT_64 *nodes, UINT_64 *next_bound);
+
+/**
+ * @brief                   Searches for a shortest solution of the given board state with
+ *                              depth-first searches under increasing cost bounds: plain
+ *                              iterative deepening, or IDA* when \c informed. Memory use
+ *                              grows with the solution length only, plus the optional table.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] table         - Transposition table, may be NULL
+ * @param[in] informed      - Whether to bound by depth plus goalEstimate rather than depth
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes visited over every iteration
+ *
+ * @return                  true if a solution was found.
+ */
+bool iterativeDeepening(board_state *source, transposition_table *table, bool informed,
+                        sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Lower bound on the number of moves needed to solve \c source.
+ *                              Every goal cell still uncovered needs some master cell to
+ *                              travel onto it, one cell per move, so the largest over those
+ *                              cells of the Manhattan distance to the nearest master cell
+ *                              never overestimates. Goals the master already covered are
+ *                              CLEAR and do not count, and the estimate is 0 once none are
+ *                              left. It drops by at most one per move.
+ *
+ * @param[in] source        - Board state to estimate
+ *
+ * @return                  Estimated number of moves to the goal.
+ */
+UINT_64 masterGoalDistance(board_state *source);
+
+/**
+ * @brief                   Searches for a shortest solution of the given board state with A*,
+ *                              guided by goalEstimate. Open nodes are kept in buckets
+ *                              by estimated solution length.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] closed        - Set of canonical keys of board states already expanded
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes expanded in the search
+ *
+ * @return                  true if a solution was found.
+ */
+bool aStar(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Enumerates solved boards by placing piece \c k onwards of \c seeder
+ *                              on its board in every possible way. Each arrangement is added
+ *                              to the seeder's frontier as a root unless an equivalent one was.
+ *
+ * @param[in] seeder        - Enumeration state, the master already placed
+ * @param[in] k             - Position in \c seeder->labels of the next piece to place
+ * @param[in] first         - Smallest anchor cell the piece may take
+ */
+void seedGoalSet(goal_seeder *seeder, UINT_64 k, UINT_64 first);
+
+/**
+ * @brief                   Adds every solved board to the frontier of \c seeder: the master
+ *                              over all goal cells and the other pieces in any arrangement
+ *                              of the remaining open cells. Stops with \c seeder->overflow
+ *                              set once more than \c seeder->limit boards are found.
+ *
+ * @param[in] seeder        - Enumeration state, its board emptied down to walls and goal cells
+ */
+void seedGoalBoards(goal_seeder *seeder);
+
+/**
+ * @brief                   Searches for a shortest solution breadth-first from both ends: forward
+ *                              from \c source and backward from every solved board with the master
+ *                              covering the goal cells. The backward half never lets the master
+ *                              leave a goal cell, under which rule every move can be undone.
+ *                              It is only seeded once a forward layer outgrows the solved
+ *                              boards; from then on the smaller frontier is expanded a whole
+ *                              layer at a time until the two meet.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes added to either half, seeds included
+ *
+ * @return                  true if a solution was found.
+ */
+bool bidirectionalSearch(board_state *source, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Runs worker \c worker of a parallel breadth-first search until the
+ *                              search ends. Worker 0 also performs the serial steps between
+ *                              the parallel phases of a layer.
+ *
+ * @param[in] worker        - Worker to run
+ */
+void layerWorkerRun(layer_worker *worker);
+
+/**
+ * @brief                   Thread entry point of every worker but the first.
+ *
+ * @param[in] p             - Worker to run
+ *
+ * @return                  NULL
+ */
+void *layerWorkerMain(void *p);
+
+/**
+ * @brief                   Breadth-first search expanding each layer across \c threads workers.
+ *                              Finds the same solution as uninformedBreadthFirst for any
+ *                              number of workers.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] threads       - Number of workers, the calling thread included
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes added to the frontier
+ *
+ * @return                  true if a solution was found.
+ */
+bool parallelBreadthFirst(board_state *source, UINT_64 threads, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Determines whether two solutions consist of the same moves.
+ *
+ * @param[in] a             - First list of moves
+ * @param[in] b             - Second list of moves
+ *
+ * @return                  true if the solutions are identical.
+ */
+bool solutionsEqual(sk_list *a, sk_list *b);
+
+/**
+ * @brief                   Accepts \c node at the worker owning its hash, unless an equal state
+ *                              was already reached by a path no longer, or the node cannot
+ *                              lead to a solution shorter than the best one found.
+ *
+ * @param[in] worker        - Owner of \c node
+ * @param[in] node          - Node to accept, freed if rejected
+ */
+void hdaReceive(hda_worker *worker, hda_node *node);
+
+/**
+ * @brief                   Runs worker \c worker of a hash distributed A* until the search ends.
+ *
+ * @param[in] worker        - Worker to run
+ */
+void hdaWorkerRun(hda_worker *worker);
+
+/**
+ * @brief                   Thread entry point of every hash distributed A* worker but the first.
+ *
+ * @param[in] p             - Worker to run
+ *
+ * @return                  NULL
+ */
+void *hdaWorkerMain(void *p);
+
+/**
+ * @brief                   Searches for a shortest solution with A* spread over \c threads
+ *                              workers. Each state belongs to the worker selected by its hash,
+ *                              which alone keeps its open and closed entries. Successors are
+ *                              mailed to their owners.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] threads       - Number of workers, the calling thread included
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes expanded by all workers
+ *
+ * @return                  true if a solution was found.
+ */
+bool hashDistributedAStar(board_state *source, UINT_64 threads, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Answers a pending request of another worker for work, handing
+ *                              over the bottom entry of \c worker's open stack if it has one.
+ *
+ * @param[in] worker        - Worker to check for requests
+ */
+void serveStealRequest(stealing_worker *worker);
+
+/**
+ * @brief                   Asks the other workers for work in turn until one hands some over,
+ *                              then rebuilds the working path to the parent of the entry
+ *                              received and pushes the entry.
+ *
+ * @param[in] worker        - Worker without work
+ *
+ * @return                  true if work was received, false if the search is over.
+ */
+bool stealWork(stealing_worker *worker);
+
+/**
+ * @brief                   Runs worker \c worker of a work-stealing depth-first search until
+ *                              the search ends.
+ *
+ * @param[in] worker        - Worker to run
+ */
+void stealingWorkerRun(stealing_worker *worker);
+
+/**
+ * @brief                   Thread entry point of every work-stealing worker but the first.
+ *
+ * @param[in] p             - Worker to run
+ *
+ * @return                  NULL
+ */
+void *stealingWorkerMain(void *p);
+
+/**
+ * @brief                   Searches depth-first for a solution with \c threads workers sharing
+ *                              one lock-free closed set and stealing work from each other. The
+ *                              first solution reached ends the search, as does the closed set
+ *                              filling up. With a single worker the search is that of
+ *                              uninformedDepthFirst.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] threads       - Number of workers, the calling thread included
+ * @param[in] entries       - Capacity of the closed set
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes visited by all workers
+ *
+ * @return                  true if a solution was found.
+ */
+bool stealingDepthFirst(board_state *source, UINT_64 threads, UINT_64 entries, sk_list *soln,
+                        UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Builds key number \c k of the atomic key set benchmark.
+ *
+ * @param[in] k             - Key number
+ * @param[in] key_size      - Bytes per key, at least those of a UINT_64
+ * @param[out] key          - Key bytes
+ *
+ * @return                  Fingerprint of the key.
+ */
+UINT_64 setBenchKey(UINT_64 k, UINT_64 key_size, UINT_8 *key);
+
+/**
+ * @brief                   Thread entry point of an atomic key set benchmark worker.
+ *
+ * @param[in] p             - Worker to run
+ *
+ * @return                  NULL
+ */
+void *setBenchWorkerMain(void *p);
+
+/**
+ * @brief                   Stress tests and times sk_atomic_key_set at every power of two
+ *                              thread count up to \c max_threads, with keys the size of the
+ *                              loaded level's closed set keys. Each run checks that every key
+ *                              was reported new exactly once and can be found afterwards.
+ *
+ * @param[in] max_threads   - Largest thread count to run
+ *
+ * @return                  true if every run passed its checks.
+ */
+bool atomicSetBenchmark(UINT_64 max_threads);
+
+/**
+ * @brief                   Seconds on the monotonic clock, for timing pipeline stages.
+ *
+ * @return                  Current time in seconds.
+ */
+double monotonicSeconds();
+
+/**
+ * @brief                   Populates \c dest as a view of a board stored in \c tiles.
+ *
+ * @param[in] shape         - Board whose dimensions and pieces the stored one shares
+ * @param[in] tiles         - Board buffer of BOARD_BUFFER_SIZE(shape) tiles
+ * @param[in] hash          - Zobrist hash of the stored board
+ * @param[out] dest         - Board state to point at \c tiles
+ */
+void boardView(board_state *shape, tile_t *tiles, UINT_64 hash, board_state *dest);
+
+/**
+ * @brief                   Populates \c dest as a view of successor \c i of \c batch.
+ *
+ * @param[in] search        - Search the batch belongs to
+ * @param[in] batch         - Batch holding the successor
+ * @param[in] i             - Successor within the batch
+ * @param[out] dest         - Board state to point at the successor's tiles
+ */
+void batchBoard(pipeline_search *search, pipeline_batch *batch, UINT_64 i, board_state *dest);
+
+/**
+ * @brief                   Encoding stage: computes the canonical key of every successor.
+ *
+ * @param[in] search        - Search the batch belongs to
+ * @param[in] batch         - Batch to process
+ */
+void pipelineEncode(pipeline_search *search, pipeline_batch *batch);
+
+/**
+ * @brief                   Detecting stage: adds every successor's key to the closed set,
+ *                              flagging those not seen before.
+ *
+ * @param[in] search        - Search the batch belongs to
+ * @param[in] batch         - Batch to process
+ */
+void pipelineDetect(pipeline_search *search, pipeline_batch *batch);
+
+/**
+ * @brief                   Thread entry point of the encoding and detecting stages.
+ *
+ * @param[in] p             - Stage to run
+ *
+ * @return                  NULL
+ */
+void *pipelineStageMain(void *p);
+
+/**
+ * @brief                   Breadth-first search with successor generation, key encoding and
+ *                              duplicate detection running as separate pipelined threads.
+ *                              Finds the same solution as uninformedBreadthFirst.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of nodes added to the frontier
+ *
+ * @return                  true if a solution was found.
+ */
+bool pipelinedBreadthFirst(board_state *source, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Writes all of \c data to a socket.
+ *
+ * @param[in] fd            - Blocking socket to write to
+ * @param[in] data          - Bytes to write
+ * @param[in] size          - Number of bytes
+ *
+ * @return                  true if every byte was written.
+ */
+bool sendFully(int fd, const void *data, UINT_64 size);
+
+/**
+ * @brief                   Reads exactly \c size bytes from a socket.
+ *
+ * @param[in] fd            - Blocking socket to read from
+ * @param[out] data         - Buffer to fill
+ * @param[in] size          - Number of bytes
+ *
+ * @return                  true if every byte was read.
+ */
+bool receiveFully(int fd, void *data, UINT_64 size);
+
+/**
+ * @brief                   Grows \c buffer to hold at least \c size bytes.
+ *
+ * @param[in] buffer        - Buffer to grow
+ * @param[in] size          - Bytes needed
+ */
+void mpBufferReserve(mp_buffer *buffer, UINT_64 size);
+
+/**
+ * @brief                   Sends every worker its batch from \c worker and receives theirs,
+ *                              interleaving reads and writes so that no two workers wait
+ *                              on each other's full socket.
+ *
+ * @param[in] worker        - Worker exchanging its outgoing batches
+ *
+ * @return                  true if every batch went through.
+ */
+bool mpExchange(mp_worker *worker);
+
+/**
+ * @brief                   Adds the states of a received batch that this worker has not
+ *                              seen yet to its closed set and next layer.
+ *
+ * @param[in] worker        - Owner of every state in the batch
+ * @param[in] buffer        - Batch of successor records
+ *
+ * @return                  Number of new states.
+ */
+UINT_64 mpAbsorb(mp_worker *worker, mp_buffer *buffer);
+
+/**
+ * @brief                   Expands the current layer of \c worker, exchanges successors
+ *                              with the other workers and absorbs those it owns.
+ *
+ * @param[in] worker        - Worker to advance a layer
+ * @param[out] report       - New states, and the solving move if one was generated
+ *
+ * @return                  true unless communication failed.
+ */
+bool mpExpandLayer(mp_worker *worker, mp_report *report);
+
+/**
+ * @brief                   Serves the coordinator's commands until told to stop. Runs in
+ *                              a forked worker process.
+ *
+ * @param[in] worker        - Worker to run
+ * @param[in] source        - Board state being solved
+ *
+ * @return                  true if the worker stopped on command.
+ */
+bool mpWorkerRun(mp_worker *worker, board_state *source);
+
+/**
+ * @brief                   Breadth-first search across forked worker processes, each owning
+ *                              the states whose hash maps to it and exchanging successors
+ *                              with the others over Unix domain sockets. The calling process
+ *                              coordinates the layers and walks back the solution.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] workers       - Number of worker processes
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of states reached
+ *
+ * @return                  true if a solution was found.
+ */
+bool distributedBreadthFirst(board_state *source, UINT_64 workers, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Orders records of the external memory search by state key.
+ *
+ * @param[in] a             - Pointer to a record pointer
+ * @param[in] b             - Pointer to a record pointer
+ *
+ * @return                  Negative, zero or positive as a's key sorts before, with or
+ *                              after b's.
+ */
+int compareExternalRecords(const void *a, const void *b);
+
+/**
+ * @brief                   Sorts the records of the sort buffer and writes them, without
+ *                              repeated states, to a new run file.
+ *
+ * @param[in] search        - Search whose sort buffer to empty
+ *
+ * @return                  true if the run was written.
+ */
+bool writeExternalRun(external_search *search);
+
+/**
+ * @brief                   Advances a sorted layer stream to the first record whose key is
+ *                              not less than \c key.
+ *
+ * @param[in] stream        - Stream over a layer file
+ * @param[in,out] head      - Current record of the stream, NULL once exhausted
+ * @param[in] key           - State key to look for
+ * @param[in] key_size      - Bytes of the state key
+ *
+ * @return                  true if the layer holds \c key.
+ */
+bool externalLayerContains(sk_record_stream *stream, const UINT_8 **head, const UINT_8 *key, UINT_64 key_size);
+
+/**
+ * @brief                   Merges the runs of the layer being generated into its layer file,
+ *                              dropping states repeated across runs or present in either
+ *                              of the two layers before it.
+ *
+ * @param[in] search        - Search whose runs to merge
+ *
+ * @return                  true if the layer was written.
+ */
+bool mergeExternalLayer(external_search *search);
+
+/**
+ * @brief                   Breadth-first search keeping its layers in files rather than in
+ *                              memory. Duplicate detection is delayed until a layer is
+ *                              complete, and every file is read and written sequentially.
+ *
+ * @param[in] source        - Board state to solve
+ * @param[in] memory        - Bytes of buffers the search may hold at once
+ * @param[out] soln         - List to populate with solution moves
+ * @param[out] nodes_visited- Number of states reached
+ *
+ * @return                  true if a solution was found.
+ */
+bool externalBreadthFirst(board_state *source, UINT_64 memory, sk_list *soln, UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Determines whether a snapshot should be taken now: the interval
+ *                              has passed and no earlier snapshot is still being written.
+ *
+ * @param[in] writer        - Snapshot settings and state
+ *
+ * @return                  true if the search should call beginCheckpoint.
+ */
+bool checkpointDue(checkpoint_writer *writer);
+
+/**
+ * @brief                   Forks a process to write a snapshot of the search. In that process,
+ *                              writes the header and the closed set, and returns the open
+ *                              snapshot for the search to add its own state to before
+ *                              calling endCheckpoint.
+ *
+ * @param[in] writer        - Snapshot settings and state
+ * @param[in] mode          - CHECKPOINT_DEPTH or CHECKPOINT_BREADTH
+ * @param[in] source        - Board state the search started from
+ * @param[in] closed        - Closed set of the search
+ * @param[in] nodes_visited - Nodes visited so far
+ *
+ * @return                  The snapshot in the writing process, NULL in the searching one.
+ */
+FILE *beginCheckpoint(checkpoint_writer *writer, UINT_64 mode, board_state *source, sk_key_table *closed,
+                      UINT_64 nodes_visited);
+
+/**
+ * @brief                   Marks the end of a snapshot, moves it over the previous one and
+ *                              ends the writing process.
+ *
+ * @param[in] writer        - Snapshot settings and state
+ * @param[in] out           - Snapshot returned by beginCheckpoint
+ */
+void endCheckpoint(checkpoint_writer *writer, FILE *out);
+
+/**
+ * @brief                   Opens the snapshot to resume from, checks that it is complete and
+ *                              was taken by this search on this board, and restores the closed
+ *                              set and node count from it. Reports any failure as an error.
+ *
+ * @param[in] writer        - Snapshot settings and state
+ * @param[in] mode          - Search resuming, which must be the one that took the snapshot
+ * @param[in] source        - Board state the search starts from
+ * @param[in] closed        - Empty closed set to fill
+ * @param[out] nodes_visited- Nodes visited before the snapshot
+ *
+ * @return                  The snapshot, positioned at the search's own state, or NULL if it
+ *                              cannot be resumed.
+ */
+FILE *openCheckpoint(checkpoint_writer *writer, UINT_64 mode, board_state *source, sk_key_table *closed,
+                     UINT_64 *nodes_visited);
+
+/**
+ * @brief                   Waits for a snapshot still being written and reports how many
+ *                              were taken.
+ *
+ * @param[in] writer        - Snapshot settings and state
+ */
+void finishCheckpoints(checkpoint_writer *writer);
+
+/**
+ * @brief                   Writes the nodes of \c frontier, and the boards of those not yet
+ *                              expanded, to a snapshot.
+ *
+ * @param[in] frontier      - Frontier to write
+ * @param[in] out           - Snapshot to write to
+ *
+ * @return                  true if everything was written.
+ */
+bool saveBreadthFrontier(breadth_frontier *frontier, FILE *out);
+
+/**
+ * @brief                   Rebuilds a frontier written by saveBreadthFrontier.
+ *
+ * @param[in] frontier      - Frontier freshly initialized from the same source board
+ * @param[in] in            - Snapshot to read from
+ *
+ * @return                  true if the whole frontier was read back.
+ */
+bool restoreBreadthFrontier(breadth_frontier *frontier, FILE *in);
+
+/**
+ * @brief                   Hashes the board dimensions, walls and goal cells of a level,
+ *                              identifying the levels a pattern file applies to.
+ *
+ * @param[in] source        - Board state of the level
+ *
+ * @return                  Layout hash.
+ */
+UINT_64 levelLayoutHash(board_state *source);
+
+/**
+ * @brief                   Hashes the shape of \c piece, independently of its position.
+ *
+ * @param[in] source        - Board state holding the piece
+ * @param[in] piece         - Piece to describe
+ *
+ * @return                  Shape hash.
+ */
+UINT_64 pieceShapeHash(board_state *source, SINT_64 piece);
+
+/**
+ * @brief                   Index of the live cell \c cell in a pattern database.
+ *
+ * @param[in] source        - Board state of the level
+ * @param[in] cell          - Non-wall cell
+ *
+ * @return                  Row-major position of \c cell in the level's live bounding box.
+ */
+UINT_64 liveAnchor(board_state *source, UINT_64 cell);
+
+/**
+ * @brief                   Tabulates the binomial coefficients ranking the anchor sets of
+ *                              pattern databases, for use with PDB_BINOMIAL.
+ *
+ * @return                  Table of (live cells + 1) * (PDB_MAX_PIECES + 1) coefficients.
+ */
+UINT_64 *patternBinomials(void);
+
+/**
+ * @brief                   Table index of a placement of the pattern pieces.
+ *
+ * @param[in] pattern       - Pattern database
+ * @param[in] binomials     - Result of patternBinomials
+ * @param[in,out] anchors   - Live anchor of each pattern piece, sorted within each group
+ *                              on return
+ *
+ * @return                  Entry of the placement in the pattern's table.
+ */
+UINT_64 patternIndex(const pattern_database *pattern, const UINT_64 *binomials, UINT_64 *anchors);
+
+/**
+ * @brief                   Inverse of patternIndex.
+ *
+ * @param[in] pattern       - Pattern database
+ * @param[in] binomials     - Result of patternBinomials
+ * @param[in] index         - Entry of the pattern's table
+ * @param[out] anchors      - Live anchor of each pattern piece, ascending within each group
+ */
+void patternAnchors(const pattern_database *pattern, const UINT_64 *binomials, UINT_64 index, UINT_64 *anchors);
+
+/**
+ * @brief                   Lays out the pattern pieces at \c anchors.
+ *
+ * @param[in] builder       - Build to lay the pieces out in
+ * @param[in] anchors       - Live anchor of each pattern piece
+ *
+ * @return                  true if every piece fits without overlapping a wall, another
+ *                              piece or, unless it is the master, a goal cell.
+ */
+bool placePattern(pattern_builder *builder, const UINT_64 *anchors);
+
+/**
+ * @brief                   Fills \c table with the fewest moves to the goal of every
+ *                              placement of the pattern pieces, by breadth-first search back
+ *                              from every placement where the master covers the goal.
+ *
+ * @param[in] source        - Board state of the level, with the pieces' shapes
+ * @param[in] pattern       - Pattern pieces and groups
+ * @param[in] entries       - Entries of the pattern's table
+ * @param[out] table        - Table to fill
+ *
+ * @return                  Largest distance found.
+ */
+UINT_64 buildPatternTable(board_state *source, const pattern_database *pattern, UINT_64 entries, UINT_8 *table);
+
+/**
+ * @brief                   Builds pattern databases for the level of \c source and writes
+ *                              them to a pattern file. The shapes closest to the goal are
+ *                              grouped with the master into as many databases as needed.
+ *
+ * @param[in] source        - Board state of the level
+ * @param[in] path          - File to write
+ *
+ * @return                  true if the file was written.
+ */
+bool writePatternFile(board_state *source, const char *path);
+
+/**
+ * @brief                   Maps a pattern file into memory for patternDistance, keeping the
+ *                              databases whose pieces have the same shapes in \c source.
+ *
+ * @param[in] source        - Board state of the level to search
+ * @param[in] path          - File written by writePatternFile
+ * @param[out] patterns     - Set to load the databases into
+ *
+ * @return                  true if the file is for this level and a database was kept.
+ */
+bool loadPatternFile(board_state *source, const char *path, pattern_set *patterns);
+
+/**
+ * @brief                   Largest estimate of the loaded pattern databases.
+ *
+ * @param[in] source        - Board state to estimate
+ *
+ * @return                  Lower bound of the moves needed to solve \c source.
+ */
+UINT_64 patternDistance(board_state *source);
+
+/**
+ * @brief                   Admissible estimate of the informed searches: masterGoalDistance,
+ *                              raised to patternDistance when pattern databases are loaded.
+ *
+ * @param[in] source        - Board state to estimate
+ *
+ * @return                  Lower bound of the moves needed to solve \c source.
+ */
+UINT_64 goalEstimate(board_state *source);
+
+/**
+ * @brief                   Frees every move of \c soln, leaving it empty.
+ *
+ * @param[in] soln          - List of moves to empty
+ */
+void clearSolution(sk_list *soln);
+
+/**
+ * @brief                       Debugging print function.
+ *                                  Prints output to standard error if debug level is high enough.
+ *
+ * @param[in] out               - Printer structure containing open file descriptors
+ * @param[in] level             - the level of detail of the message
+ * @param[in] fmt               - Format string to pass to printf
+ * @param[in] va_args           - Replacement pointers to pass to printf
+ */
+void app_debug(printer_t *out, int level, char *fmt, ...);
+
+/**
+ * @brief                       Keyword "f" handler.
+ *                                  Arguments: 1
+ *                                  args[1] :
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_f(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "r" handler.
+ *                                  Arguments: 1
+ *                                  args[1] :
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_r(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "d" handler.
+ *                                  Arguments: 1
+ *                                  args[1] :
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_d(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "b" handler.
+ *                                  Arguments: 1
+ *                                  args[1] :
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_b(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "bitboard" handler.
+ *                                  Arguments: 0
+ *                                  Selects the bitboard move generation engine.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_bitboard(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "i" handler.
+ *                                  Arguments: 0
+ *                                  Selects the iterative deepening search.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_i(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "tt" handler.
+ *                                  Arguments: 1
+ *                                  args[1] : Number of transposition table entries
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_tt(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "a" handler.
+ *                                  Arguments: 0
+ *                                  Selects the A* search.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_a(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "ida" handler.
+ *                                  Arguments: 0
+ *                                  Selects the IDA* search.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_ida(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "bidir" handler.
+ *                                  Arguments: 0
+ *                                  Selects the bidirectional breadth first search.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_bidir(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "pb" handler.
+ *                                  Arguments: 1
+ *                                  Selects the parallel breadth first search with the given
+ *                                  number of threads.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_pb(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "scaling" handler.
+ *                                  Arguments: 0
+ *                                  Repeats the parallel search for every power of two thread
+ *                                  count up to the one selected.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_scaling(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "hda" handler.
+ *                                  Arguments: 1
+ *                                  Selects the hash distributed A* search with the given
+ *                                  number of threads.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_hda(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "pd" handler.
+ *                                  Arguments: 1
+ *                                  Selects the work-stealing depth first search with the given
+ *                                  number of threads.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_pd(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "closed" handler.
+ *                                  Arguments: 1
+ *                                  Sets the closed set capacity of the parallel searches.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_closed(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "setbench" handler.
+ *                                  Arguments: 1
+ *                                  Selects the atomic key set benchmark up to the given
+ *                                  number of threads.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_setbench(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "pipe" handler.
+ *                                  Arguments: 0
+ *                                  Selects the pipelined breadth first search.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_pipe(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "mp" handler.
+ *                                  Arguments: 1
+ *                                  Selects the multi-process breadth first search with
+ *                                  the given number of worker processes.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_mp(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "ext" handler.
+ *                                  Arguments: 1
+ *                                  Selects the external memory breadth first search with
+ *                                  the given memory cap in megabytes.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_ext(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "checkpoint" handler.
+ *                                  Arguments: 1
+ *                                  Periodically writes a snapshot of the depth first or
+ *                                  breadth first search to the given file.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_checkpoint(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "interval" handler.
+ *                                  Arguments: 1
+ *                                  Sets the seconds between search snapshots.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_interval(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "resume" handler.
+ *                                  Arguments: 1
+ *                                  Continues the depth first or breadth first search from
+ *                                  the snapshot in the given file.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_resume(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "pdbbuild" handler.
+ *                                  Arguments: 1
+ *                                  Builds pattern databases for the level and writes them
+ *                                  to the given file.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_pdbbuild(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "pdb" handler.
+ *                                  Arguments: 1
+ *                                  Guides the informed searches with the pattern databases
+ *                                  of the given file.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_pdb(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword "verbose" handler.
+ *                                  Arguments: 0
+ *                                  Raises the debug level of the program to maximum.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_verbose(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Keyword miss handler.
+ *                                  Handles arguments not matching any registered keyword.
+ *
+ * @param[in] match             - Input argument string which matches registered keyword
+ * @param[in] args              - Arguments following the keyword
+ * @param[in] handle            - Handle to common state
+ */
+void handle_miss(sk_str *match, sk_str **args, void *handle);
+
+/**
+ * @brief                       Parses the input argument array for configuration parameters.
+ *
+ * @param[in] state             - State to update with configuration
+ * @param[in] argc              - Number of command line arguments
+ * @param[in] argv              - Argument array
+ *
+ * @return                      true if the argument vector was successfully processed.
+ */
+bool interpret_input_arguments(global_state *state, int argc, char **argv);
+
+/**
+ * @brief                       Validates the global state against program assumptions.
+ *
+ * @param[in] state             - State to check.
+ *
+ * @return                      true if the passed state is valid for program execution.
+ */
+bool validate_global_state(global_state *state);
+
+/**
+ * @brief                       Performs memory cleanup on global state \c p.
+ *
+ * @param[in] p                 - Pointer to destroy
+ */
+void destroy_global_state(void *p);
+
+/**
+ * @brief                   Attempts to expand \c filename into an absolute path.
+ *                              Checks for the existence of a file at that path.
+ *
+ * @param[in] filename      - a filename to search for.
+ *                              Can either be an absolute path or a single filename.
+ * @param[out] resolved     - a reference into which to store the absolute path to the found file.
+ *
+ * @return                  true if a matching file was found
+ */
+bool resolve_input_file(const char *filename, sk_str **resolved);
+
+/**
+ * @brief                   File existential query function.
+ *
+ * @param path              - a path to check for file existence over.
+ *
+ * @returns                 true if a file exists that is represented by the given path
+ */
+bool exists(sk_str *path);
+
+/**
+ * @brief                   Reliably reads \c n bytes from file \c fd into buffer \c dst.
+ *
+ * @param[in] fd            - file descriptor of file to read.
+ * @param[out] dst          - destination buffer
+ * @param[in] n             - number of bytes to read in
+ *
+ * @return                  the number of bytes successfully read.
+ *                          -1 on error.
+ */
+SINT_64 r_fread(int fd, void *dst, UINT_64 n);
+
+/**
+ * @brief                   Retrieves a string from the given file.
+ *                              Input halts at newline, and skips over '\0' characters.
+ *
+ * @param[out] s            - Destination buffer
+ * @param[in] n             - Max number of characters to read in
+ * @param[in] fd            - file descriptor of file to read
+ *
+ * @return                  The number of characters read.
+ */
+UINT_64 _ngets(char *s, UINT_64 n, int fd);
+
+/**
+ * @brief                   Retrieves a line from the given file.
+ *
+ * @param[in] fd            - File descriptor of file to read.
+ * @param[out] dest         - Destination string.
+ *
+ * @return                  true if a line was able to be retrieved from the file.
+ */
+bool fd_get_line(int fd, sk_str *dest);
+
+int main (int argc, char **argv)
+{
+    printer_t *printer = Printer();
+    printer->debug = app_debug;
+    printer->debug_level = DEBUG_NONE;
+
+    sk_random_default_init(&state.random);
+
+    int retval = EXIT_SUCCESS;
+
+    state.printer = printer;
+    state.input_file_path = "./assets/SBP-level0.txt";
+    state.resolved_path = NULL;
+    state.random_walk = false;
+    state.breadth_first = false;
+    state.depth_first = false;
+    state.iterative_deepening = false;
+    state.astar = false;
+    state.ida_star = false;
+    state.bidirectional = false;
+    state.parallel_threads = 0;
+    state.hda_threads = 0;
+    state.stealing_threads = 0;
+    state.closed_entries = 0;
+    state.set_bench_threads = 0;
+    state.pipelined = false;
+    state.mp_workers = 0;
+    state.ext_memory = 0;
+    memset(&state.checkpoint, 0, sizeof(state.checkpoint));
+    state.checkpoint.interval = CHECKPOINT_INTERVAL;
+    state.pdb_build_path = NULL;
+    state.pdb_path = NULL;
+    memset(&state.patterns, 0, sizeof(state.patterns));
+    state.scaling = false;
+    state.tt_entries = TT_ENTRIES_UNSET;
+    state.engine = ENGINE_GRID;
+    state.bitboard_words = 0;
+    state.game_state = NULL;
+
+
+    // Step 0: Retrieve program configuration from command line
+    if (!interpret_input_arguments(&state, argc, argv))
+    {
+        state.printer->error(state.printer, "Failed to interpret input arguments. Aborting.\n");
+        retval = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    // Step 0: Ensure that program configuration is valid.
+    if (!validate_global_state(&state))
+    {
+        state.printer->error(state.printer, "Program configuaration invalid. Aborting.\n");
+        retval = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    // Retrieve and normalize the starting state
+    loadGameState(state.resolved_path->string);
+    normalizeState(state.game_state);
+
+    if (!initLevelInfo(state.game_state, &state.level))
+    {
+        state.printer->error(state.printer, "Failed to describe level. Aborting.\n");
+        retval = EXIT_FAILURE;
+        goto cleanup;
+    }
+    state.game_state->hash = zobristHash(state.game_state);
+
+    if (ENGINE_BITBOARD == state.engine)
+    {
+        state.bitboard_words = (CELLS(state.game_state) + 63) / 64;
+        if (state.bitboard_words > BITBOARD_WORDS)
+        {
+            state.printer->error(state.printer,
+                                "Board too large for bitboard engine (%lu cells). Using grid engine.\n",
+                                CELLS(state.game_state));
+            state.engine = ENGINE_GRID;
+        }
+        else
+        {
+            // Make room for the masks kept with every board
+            initBitboardMasks(state.game_state);
+            indexPieces(state.game_state);
+        }
+    }
+
+    if (state.pdb_path && !loadPatternFile(state.game_state, state.pdb_path, &state.patterns))
+    {
+        state.printer->error(state.printer, "Failed to load pattern databases. Aborting.\n");
+        retval = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    if (state.random_walk)
+    {
+        // Perform N random moves upon the starting state
+        randomWalks(state.game_state, state.N);
+    }
+    else if (state.depth_first)
+    {
+        sk_list soln;
+        sk_key_table closed;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+        sk_key_table_init(&closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT);
+
+        // A snapshot that cannot be resumed must not pass for a search that found nothing
+        if (state.checkpoint.resume
+         && !(state.checkpoint.input = openCheckpoint(&state.checkpoint, CHECKPOINT_DEPTH, state.game_state,
+                                                      &closed, &nodes)))
+        {
+            state.printer->error(state.printer, "Failed to resume the search. Aborting.\n");
+            retval = EXIT_FAILURE;
+        }
+        else
+        {
+            struct timeval start, stop;
+            gettimeofday(&start, NULL);
+            bool found = uninformedDepthFirst(state.game_state, &closed, &soln, &nodes);
+            if (state.checkpoint.input)
+            {
+                fclose(state.checkpoint.input);
+                state.checkpoint.input = NULL;
+            }
+
+            if (state.checkpoint.resume_failed)
+            {
+                state.printer->error(state.printer, "Failed to resume the search. Aborting.\n");
+                retval = EXIT_FAILURE;
+            }
+            else
+            {
+                if (!found)
+                {
+                    printf("No solution found!\n");
+                }
+                else
+                {
+                    gettimeofday(&stop, NULL);
+                    printSolution(&soln, nodes, &start, &stop);
+                }
+                printClosedStats(&closed);
+            }
+            finishCheckpoints(&state.checkpoint);
+        }
+
+        sk_key_table_destroy(&closed);
+        sk_list_destroy(&soln);
+    }
+    else if (state.breadth_first)
+    {
+        sk_list soln;
+        sk_key_table closed;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+        sk_key_table_init(&closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT);
+
+        // A snapshot that cannot be resumed must not pass for a search that found nothing
+        if (state.checkpoint.resume
+         && !(state.checkpoint.input = openCheckpoint(&state.checkpoint, CHECKPOINT_BREADTH, state.game_state,
+                                                      &closed, &nodes)))
+        {
+            state.printer->error(state.printer, "Failed to resume the search. Aborting.\n");
+            retval = EXIT_FAILURE;
+        }
+        else
+        {
+            struct timeval start, stop;
+            gettimeofday(&start, NULL);
+            bool found = uninformedBreadthFirst(state.game_state, &closed, &soln, &nodes);
+            if (state.checkpoint.input)
+            {
+                fclose(state.checkpoint.input);
+                state.checkpoint.input = NULL;
+            }
+
+            if (state.checkpoint.resume_failed)
+            {
+                state.printer->error(state.printer, "Failed to resume the search. Aborting.\n");
+                retval = EXIT_FAILURE;
+            }
+            else
+            {
+                if (!found)
+                {
+                    printf("No solution found!\n");
+                }
+                else
+                {
+                    gettimeofday(&stop, NULL);
+                    printSolution(&soln, nodes, &start, &stop);
+                }
+                printClosedStats(&closed);
+            }
+            finishCheckpoints(&state.checkpoint);
+        }
+
+        sk_key_table_destroy(&closed);
+        sk_list_destroy(&soln);
+    }
+    else if (state.iterative_deepening || state.ida_star)
+    {
+        // Without a table neither search notices cycles, nor that it has run out of states
+        UINT_64 entries = state.tt_entries;
+        if (entries == TT_ENTRIES_UNSET)
+        {
+            entries = DEPTH_TT_ENTRIES;
+        }
+
+        sk_list soln;
+        transposition_table table;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+        initTranspositionTable(&table, entries);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!iterativeDeepening(state.game_state, entries ? &table : NULL, state.ida_star, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+        if (entries)
+        {
+            printTranspositionStats(&table);
+        }
+
+        destroy_transposition_table(&table);
+        sk_list_destroy(&soln);
+    }
+    else if (state.parallel_threads)
+    {
+        // With -scaling every power of two thread count runs before the requested one,
+        //      each checked to find the solution of the single threaded run
+        sk_list soln;
+        sk_list reference;
+        sk_list_init(&soln, NULL);
+        sk_list_init(&reference, NULL);
+        UINT_64 nodes = 0;
+        UINT_64 threads = state.scaling ? 1 : state.parallel_threads;
+        float base_time = 0;
+        bool found = false;
+
+        struct timeval start, stop;
+        while (true)
+        {
+            clearSolution(&soln);
+            nodes = 0;
+            gettimeofday(&start, NULL);
+            found = parallelBreadthFirst(state.game_state, threads, &soln, &nodes);
+            gettimeofday(&stop, NULL);
+
+            float elapsed = stop.tv_sec - start.tv_sec + (stop.tv_usec - start.tv_usec)/(float)1000000;
+            if (1 == threads)
+            {
+                base_time = elapsed;
+            }
+            printf("Threads: %lu, Nodes: %lu, Time: %0.4f s, Nodes/sec: %0.0f",
+                    threads, nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0);
+            if (state.scaling && elapsed > 0)
+            {
+                printf(", Speedup: %0.2f", base_time / elapsed);
+            }
+            printf("\n");
+
+            if (state.scaling)
+            {
+                if (1 == threads)
+                {
+                    sk_list_destroy(&reference);
+                    reference = soln;
+                    sk_list_init(&soln, NULL);
+                }
+                else if (!solutionsEqual(&reference, &soln))
+                {
+                    state.printer->error(state.printer, "Error: Solution differs with %lu threads.\n", threads);
+                }
+            }
+
+            if (threads == state.parallel_threads)
+            {
+                break;
+            }
+
+            threads = threads * 2 < state.parallel_threads ? threads * 2 : state.parallel_threads;
+        }
+
+        if (!found)
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        clearSolution(&reference);
+        sk_list_destroy(&reference);
+        sk_list_destroy(&soln);
+    }
+    else if (state.pdb_build_path)
+    {
+        if (!writePatternFile(state.game_state, state.pdb_build_path))
+        {
+            retval = EXIT_FAILURE;
+        }
+    }
+    else if (state.ext_memory)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!externalBreadthFirst(state.game_state, state.ext_memory, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.mp_workers)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!distributedBreadthFirst(state.game_state, state.mp_workers, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.pipelined)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!pipelinedBreadthFirst(state.game_state, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.set_bench_threads)
+    {
+        if (!atomicSetBenchmark(state.set_bench_threads))
+        {
+            retval = EXIT_FAILURE;
+        }
+    }
+    else if (state.stealing_threads)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        UINT_64 entries = state.closed_entries ? state.closed_entries : PARALLEL_CLOSED_ENTRIES;
+        if (!stealingDepthFirst(state.game_state, state.stealing_threads, entries, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.hda_threads)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!hashDistributedAStar(state.game_state, state.hda_threads, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.bidirectional)
+    {
+        sk_list soln;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!bidirectionalSearch(state.game_state, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+
+        sk_list_destroy(&soln);
+    }
+    else if (state.astar)
+    {
+        sk_list soln;
+        sk_key_table closed;
+        UINT_64 nodes = 0;
+        sk_list_init(&soln, NULL);
+        sk_key_table_init(&closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT);
+
+        struct timeval start, stop;
+        gettimeofday(&start, NULL);
+        if (!aStar(state.game_state, &closed, &soln, &nodes))
+        {
+            printf("No solution found!\n");
+        }
+        else
+        {
+            gettimeofday(&stop, NULL);
+            printSolution(&soln, nodes, &start, &stop);
+        }
+        printClosedStats(&closed);
+
+        sk_key_table_destroy(&closed);
+        sk_list_destroy(&soln);
+    }
+    else
+    {
+        randomWalks(state.game_state, 3);
+    }
+
+cleanup:
+    destroy_printer(printer);
+    destroy_global_state(&state);
+
+    exit(retval);
+}
+
+bool loadGameState(const char *file_name)
+{
+    bool retval = true;
+
+    sk_str *resolved_path = NULL;
+    if (!resolve_input_file(file_name, &resolved_path))
+    {
+        state.printer->error(state.printer, "Error: Failed to resolve input file path : %s.\n", file_name);
+        retval = false;
+        goto resolve_file_fail;
+    }
+
+    int input_fd = 0;
+    if (resolved_path && (input_fd = open(resolved_path->string, O_RDONLY)) < 0)
+    {
+        state.printer->error(state.printer, "Error: Failed to open input file : %s.\n", strerror(errno));
+        retval = false;
+        goto open_fail;
+    }
+
+    UINT_64 width;
+    UINT_64 height;
+
+    sk_iterator token_it;
+    char *token;
+    sk_str str_token;
+    sk_str line;
+
+    if (!fd_get_line(input_fd, &line))
+    {
+        retval = false;
+        goto dimensions_fail;
+    }
+
+    sk_str_split(&token_it, &line, ',');
+    int t_width;
+    int t_height;
+
+    token = token_it.next(&token_it);
+    sk_str_init(&str_token, token, 10);
+    parse_int(&str_token, 10, &t_width);
+    sk_str_destroy(&str_token);
+
+    token = token_it.next(&token_it);
+    sk_str_init(&str_token, token, 10);
+    parse_int(&str_token, 10, &t_height);
+    sk_str_destroy(&str_token);
+
+    state.printer->debug(state.printer, DEBUG_DETAILS,
+                            "Found width %d  height %d.\n",
+                            t_width,
+                            t_height);
+
+    token_it.destroy(&token_it);
+
+    sk_str_destroy(&line);
+
+    if (t_width <= 0 || t_height <= 0)
+    {
+        goto dimensions_fail;
+    }
+    width = t_width;
+    height = t_height;
+
+    if (width * height > MAX_BOARD_CELLS)
+    {
+        state.printer->error(state.printer, "Error: Board of %lu cells exceeds limit of %d.\n",
+                            width * height, MAX_BOARD_CELLS);
+        retval = false;
+        goto dimensions_fail;
+    }
+
+    tile_t *tiles = ALLOC(*tiles, width * height);
+    UINT_64 i;
+    UINT_64 j;
+    for (i = 0; i < height; i++)
+    {
+        if (!fd_get_line(input_fd, &line))
+        {
+            goto matrix_fill_fail;
+        }
+
+        sk_str_split(&token_it, &line, ',');
+
+        for (j = 0; j < width; ++j)
+        {
+            if (!token_it.has_next(&token_it))
+            {
+                token_it.destroy(&token_it);
+                sk_str_destroy(&line);
+                retval = false;
+                goto matrix_fill_fail;
+            }
+            int val;
+            token = token_it.next(&token_it);
+            sk_str_init(&str_token, token, 10);
+            parse_int(&str_token, 10, &val);
+            sk_str_destroy(&str_token);
+            tiles[i * width + j] = val;
+        }
+
+        token_it.destroy(&token_it);
+
+        sk_str_destroy(&line);
+    }
+
+    state.game_state = ALLOC(*(state.game_state), 1);
+    state.game_state->width = width;
+    state.game_state->height = height;
+    state.game_state->tiles = tiles;
+    indexPieces(state.game_state);
+
+    sk_str_destroy(resolved_path);
+    free(resolved_path);
+    close(input_fd);
+    return retval;
+
+matrix_fill_fail:
+
+    free(tiles);
+dimensions_fail:
+
+    if (input_fd > 0)
+    {
+        close(input_fd);
+    }
+open_fail:
+
+    sk_str_destroy(resolved_path);
+    free(resolved_path);
+resolve_file_fail:
+
+    return retval;
+}
+
+void outputGameState()
+{
+    if (!state.game_state)
+    {
+        return;
+    }
+
+    printf("%lu,%lu,\n",
+            state.game_state->width,
+            state.game_state->height);
+
+    UINT_64 i;
+    UINT_64 j;
+    for (i = 0; i < state.game_state->height; ++i)
+    {
+        for (j = 0; j < state.game_state->width; ++j)
+        {
+            printf("%d,", TILE(state.game_state, i, j));
+        }
+
+        printf("\n");
+    }
+}
+
+void printGameState(board_state *game_state)
+{
+    if (!game_state)
+    {
+        return;
+    }
+
+    state.printer->debug(state.printer, DEBUG_DETAILS,
+                        "%lu,%lu,\n",
+                        game_state->width,
+                        game_state->height);
+
+    char *buffer = ALLOC(*buffer, game_state->width * 10);
+    char *curr = buffer;
+
+
+    UINT_64 i;
+    UINT_64 j;
+    for (i = 0; i < game_state->height; ++i)
+    {
+        curr = buffer;
+        for (j = 0; j < game_state->width; ++j)
+        {
+            curr += sprintf(curr, "%d,", TILE(game_state, i, j));
+        }
+
+        state.printer->debug(state.printer, DEBUG_DETAILS,
+                            "%s\n",
+                            buffer);
+    }
+
+    free(buffer);
+}
+
+bool cloneGameState(board_state *source, board_state *dest)
+{
+    if (!source || !dest)
+    {
+        return false;
+    }
+
+    return cloneGameStateInto(source, dest, ALLOC(*(dest->tiles), BOARD_BUFFER_SIZE(source)));
+}
+
+bool cloneGameStateInto(board_state *source, board_state *dest, tile_t *buffer)
+{
+    if (!source || !dest || !buffer)
+    {
+        return false;
+    }
+
+    UINT_64 size = BOARD_BUFFER_SIZE(source);
+
+    dest->width = source->width;
+    dest->height = source->height;
+    dest->hash = source->hash;
+    dest->max_piece = source->max_piece;
+    dest->tiles = buffer;
+    memcpy(dest->tiles, source->tiles, size * sizeof(*(source->tiles)));
+    dest->piece_first = (UINT_16 *)(dest->tiles + CELLS(dest));
+    dest->piece_cells = dest->piece_first + dest->max_piece + 2;
+
+    return true;
+}
+
+bool indexPieces(board_state *source)
+{
+    if (!source || !source->tiles)
+    {
+        return false;
+    }
+
+    UINT_64 cells = CELLS(source);
+    UINT_64 indexed = 0;
+    SINT_64 max = 3;
+    UINT_64 i;
+    for (i = 0; i < cells; ++i)
+    {
+        if (source->tiles[i] >= MASTER)
+        {
+            indexed++;
+        }
+        if (source->tiles[i] > max)
+        {
+            max = source->tiles[i];
+        }
+    }
+
+    UINT_64 size = cells + max + 2 + indexed + BOARD_MASK_TILES;
+    source->tiles = REALLOC(source->tiles, *(source->tiles), size);
+    source->max_piece = max;
+    source->piece_first = (UINT_16 *)(source->tiles + cells);
+    source->piece_cells = source->piece_first + max + 2;
+
+    UINT_16 *first = source->piece_first;
+    memset(first, 0, (max + 2) * sizeof(*first));
+
+    // Count the cells of each piece, then accumulate so first[p] is the end of piece p
+    for (i = 0; i < cells; ++i)
+    {
+        if (source->tiles[i] >= MASTER)
+        {
+            first[source->tiles[i]]++;
+        }
+    }
+    SINT_64 piece;
+    for (piece = 1; piece <= max; ++piece)
+    {
+        first[piece] += first[piece - 1];
+    }
+    first[max + 1] = indexed;
+
+    // Fill backwards, leaving first[p] at the start of piece p
+    for (i = cells; i-- > 0;)
+    {
+        if (source->tiles[i] >= MASTER)
+        {
+            source->piece_cells[--first[source->tiles[i]]] = i;
+        }
+    }
+
+    if (state.bitboard_words)
+    {
+        bitboard clear = {};
+        bitboard goal = {};
+        for (i = 0; i < cells; ++i)
+        {
+            if (CLEAR == source->tiles[i])
+            {
+                clear.bits[i / 64] |= 1UL << (i % 64);
+            }
+            else if (GOAL == source->tiles[i])
+            {
+                goal.bits[i / 64] |= 1UL << (i % 64);
+            }
+        }
+        storeBoardMasks(source, &clear, &goal);
+    }
+
+    return true;
+}
+
+bool gameStateSolved(board_state *source)
+{
+    if (!source)
+    {
+        return false;
+    }
+
+    UINT_64 i;
+    for (i = 0; i < CELLS(source); ++i)
+    {
+        if (source->tiles[i] == -1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void allMovesHelp(board_state *source, SINT_64 piece, sk_list *moves)
+{
+    if (!moves)
+    {
+        return;
+    }
+
+    sk_list_init(moves, NULL);
+
+    if (!source)
+    {
+        return;
+    }
+
+    static const direction dirs[] = { UP, DOWN, LEFT, RIGHT };
+
+    UINT_64 i;
+    for (i = 0; i < sizeof(dirs) / sizeof(*dirs); ++i)
+    {
+        if (pieceMoveLegal(source, piece, dirs[i]))
+        {
+            move *next_move = ALLOC(*next_move, 1);
+            next_move->piece = piece;
+            next_move->dir = dirs[i];
+            sk_list_append(moves, next_move);
+        }
+    }
+}
+
+bool cellStepOnBoard(const board_state *source, UINT_64 cell, direction dir)
+{
+    switch (dir)
+    {
+    case UP:
+        return cell >= source->width;
+    case DOWN:
+        return cell / source->width + 1 < source->height;
+    case LEFT:
+        return cell % source->width > 0;
+    case RIGHT:
+        return cell % source->width + 1 < source->width;
+    }
+    return false;
+}
+
+bool pieceMoveLegal(board_state *source, SINT_64 piece, direction dir)
+{
+    // Pieces absent from the board have no cells to block them
+    if (piece > source->max_piece)
+    {
+        return true;
+    }
+
+    SINT_64 offset = directionOffset(source, dir);
+    UINT_16 *cells = PIECE_CELLS(source, piece);
+    UINT_64 size = PIECE_SIZE(source, piece);
+    UINT_64 i;
+    tile_t target;
+    for (i = 0; i < size; ++i)
+    {
+        if (!cellStepOnBoard(source, cells[i], dir))
+        {
+            return false;
+        }
+
+        target = source->tiles[cells[i] + offset];
+        if ( !(  CLEAR == target
+              || piece == target
+              || (  MASTER == piece
+                 && GOAL == target
+                 )
+              )
+           )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void allMoves(board_state *source, sk_list *moves)
+{
+    if (!moves)
+    {
+        return;
+    }
+
+    sk_list_init(moves, NULL);
+
+    if (!source)
+    {
+        return;
+    }
+
+    UINT_64 capacity = MOVE_CAPACITY(source);
+    packed_move *packed = ALLOC(*packed, capacity);
+    UINT_64 num_moves = generateMoves(source, packed, capacity);
+
+    UINT_64 i;
+    for (i = 0; i < num_moves; ++i)
+    {
+        move *next_move = ALLOC(*next_move, 1);
+        *next_move = unpackMove(packed[i]);
+        sk_list_append(moves, next_move);
+    }
+
+    free(packed);
+}
+
+/**
+ * @brief                   Prepares \c scan for testing the moves of \c source with the
+ *                              selected engine.
+ */
+void beginMoveScan(board_state *source, move_scan *scan)
+{
+    scan->source = source;
+    scan->piece = -1;
+
+    if (ENGINE_BITBOARD != state.engine)
+    {
+        return;
+    }
+
+    loadBoardMasks(source, &scan->clear, &scan->goal);
+}
+
+/**
+ * @brief                   Determines whether \c piece may move in direction \c dir on the
+ *                              board of \c scan, using the selected engine.
+ */
+bool scanMoveLegal(move_scan *scan, SINT_64 piece, direction dir)
+{
+    board_state *source = scan->source;
+    if (ENGINE_BITBOARD != state.engine)
+    {
+        return pieceMoveLegal(source, piece, dir);
+    }
+
+    // Build the piece's occupancy mask from the index once per piece
+    if (scan->piece != piece)
+    {
+        memset(&scan->piece_mask, 0, sizeof(scan->piece_mask));
+        scan->piece = piece;
+        if (piece <= source->max_piece)
+        {
+            UINT_16 *cells = PIECE_CELLS(source, piece);
+            UINT_64 i;
+            for (i = 0; i < PIECE_SIZE(source, piece); ++i)
+            {
+                scan->piece_mask.bits[cells[i] / 64] |= 1UL << (cells[i] % 64);
+            }
+        }
+    }
+
+    return bitboardMoveLegal(&scan->piece_mask, piece, dir, directionOffset(source, dir),
+                             &scan->clear, &scan->goal);
+}
+
+UINT_64 generateMoves(board_state *source, packed_move *moves, UINT_64 capacity)
+{
+    if (!source)
+    {
+        return 0;
+    }
+
+    static const direction dirs[] = { UP, DOWN, LEFT, RIGHT };
+
+    move_scan scan;
+    beginMoveScan(source, &scan);
+
+    // Every piece number from MASTER up to the index's maximum is considered
+    UINT_64 num_moves = 0;
+    SINT_64 piece;
+    UINT_64 i;
+    for (piece = MASTER; piece <= source->max_piece; ++piece)
+    {
+        for (i = 0; i < sizeof(dirs) / sizeof(*dirs); ++i)
+        {
+            if (scanMoveLegal(&scan, piece, dirs[i]))
+            {
+                if (num_moves < capacity)
+                {
+                    moves[num_moves] = PACK_MOVE(piece, dirs[i]);
+                }
+                num_moves++;
+            }
+        }
+    }
+
+    return num_moves;
+}
+
+UINT_64 countMoves(board_state *source)
+{
+    return generateMoves(source, NULL, 0);
+}
+
+bool nthMove(board_state *source, UINT_64 n, packed_move *dest)
+{
+    if (!source || !dest)
+    {
+        return false;
+    }
+
+    static const direction dirs[] = { UP, DOWN, LEFT, RIGHT };
+
+    move_scan scan;
+    beginMoveScan(source, &scan);
+
+    SINT_64 piece;
+    UINT_64 i;
+    for (piece = MASTER; piece <= source->max_piece; ++piece)
+    {
+        for (i = 0; i < sizeof(dirs) / sizeof(*dirs); ++i)
+        {
+            if (scanMoveLegal(&scan, piece, dirs[i]) && 0 == n--)
+            {
+                *dest = PACK_MOVE(piece, dirs[i]);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+move unpackMove(packed_move packed)
+{
+    move expanded =
+    {
+        .piece  = MOVE_PIECE(packed),
+        .dir    = MOVE_DIR(packed)
+    };
+    return expanded;
+}
+
+void applyMove(board_state *source, move next_move)
+{
+    if (ENGINE_BITBOARD == state.engine)
+    {
+        applyMoveBitboard(source, next_move);
+        return;
+    }
+
+    if (!source || next_move.piece > source->max_piece)
+    {
+        return;
+    }
+
+    SINT_64 offset = directionOffset(source, next_move.dir);
+    if (!pieceMoveLegal(source, next_move.piece, next_move.dir))
+    {
+        return;
+    }
+
+    zobristMove(source, next_move.piece, offset);
+
+    // Vacate every cell first so that overlapping destinations are not cleared
+    UINT_16 *cells = PIECE_CELLS(source, next_move.piece);
+    UINT_64 size = PIECE_SIZE(source, next_move.piece);
+    UINT_64 i;
+    for (i = 0; i < size; ++i)
+    {
+        source->tiles[cells[i]] = CLEAR;
+    }
+    for (i = 0; i < size; ++i)
+    {
+        cells[i] += offset;
+        source->tiles[cells[i]] = next_move.piece;
+    }
+}
+
+void bitboardShift(const bitboard *src, SINT_64 shift, bitboard *dest)
+{
+    UINT_64 words = state.bitboard_words;
+    UINT_64 magnitude = shift < 0 ? -shift : shift;
+    UINT_64 word_shift = magnitude / 64;
+    UINT_64 bit_shift = magnitude % 64;
+    UINT_64 i;
+
+    for (i = 0; i < words; ++i)
+    {
+        UINT_64 hi = 0;
+        UINT_64 lo = 0;
+        if (shift >= 0)
+        {
+            // dest[i] takes src[i - word_shift] and the carry from src[i - word_shift - 1]
+            if (i >= word_shift)
+            {
+                hi = src->bits[i - word_shift] << bit_shift;
+                if (bit_shift && i >= word_shift + 1)
+                {
+                    lo = src->bits[i - word_shift - 1] >> (64 - bit_shift);
+                }
+            }
+        }
+        else
+        {
+            // dest[i] takes src[i + word_shift] and the carry from src[i + word_shift + 1]
+            if (i + word_shift < words)
+            {
+                hi = src->bits[i + word_shift] >> bit_shift;
+                if (bit_shift && i + word_shift + 1 < words)
+                {
+                    lo = src->bits[i + word_shift + 1] << (64 - bit_shift);
+                }
+            }
+        }
+        // Bits carried past the last cell do not name cells
+        dest->bits[i] = (hi | lo) & state.board_cells.bits[i];
+    }
+}
+
+SINT_64 directionOffset(const board_state *source, direction dir)
+{
+    switch (dir)
+    {
+    case UP:
+        return -(SINT_64)source->width;
+    case DOWN:
+        return source->width;
+    case LEFT:
+        return -1;
+    case RIGHT:
+        return 1;
+    }
+    return 0;
+}
+
+bool bitboardMoveLegal(const bitboard *piece_mask, SINT_64 piece, direction dir, SINT_64 offset,
+                        const bitboard *clear, const bitboard *goal)
+{
+    UINT_64 i;
+
+    // A piece on the edge it moves towards would leave the board, or wrap onto the next row
+    for (i = 0; i < state.bitboard_words; ++i)
+    {
+        if (piece_mask->bits[i] & state.edges[dir].bits[i])
+        {
+            return false;
+        }
+    }
+
+    bitboard shifted;
+    bitboardShift(piece_mask, offset, &shifted);
+
+    for (i = 0; i < state.bitboard_words; ++i)
+    {
+        UINT_64 open = piece_mask->bits[i] | clear->bits[i];
+        if (MASTER == piece)
+        {
+            open |= goal->bits[i];
+        }
+        if (shifted.bits[i] & ~open)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void initBitboardMasks(board_state *source)
+{
+    memset(&state.board_cells, 0, sizeof(state.board_cells));
+    memset(state.edges, 0, sizeof(state.edges));
+
+    UINT_64 row;
+    UINT_64 col;
+    UINT_64 i;
+    for (i = 0; i < CELLS(source); ++i)
+    {
+        UINT_64 bit = 1UL << (i % 64);
+        row = i / source->width;
+        col = i % source->width;
+        state.board_cells.bits[i / 64] |= bit;
+        if (0 == row)
+        {
+            state.edges[UP].bits[i / 64] |= bit;
+        }
+        if (source->height - 1 == row)
+        {
+            state.edges[DOWN].bits[i / 64] |= bit;
+        }
+        if (0 == col)
+        {
+            state.edges[LEFT].bits[i / 64] |= bit;
+        }
+        if (source->width - 1 == col)
+        {
+            state.edges[RIGHT].bits[i / 64] |= bit;
+        }
+    }
+}
+
+void applyMoveBitboard(board_state *source, move next_move)
+{
+    if (!source)
+    {
+        return;
+    }
+
+    if (next_move.piece > source->max_piece)
+    {
+        return;
+    }
+
+    bitboard clear;
+    bitboard goal;
+    bitboard piece_mask = {};
+    loadBoardMasks(source, &clear, &goal);
+
+    UINT_16 *cells = PIECE_CELLS(source, next_move.piece);
+    UINT_64 size = PIECE_SIZE(source, next_move.piece);
+    UINT_64 i;
+    for (i = 0; i < size; ++i)
+    {
+        piece_mask.bits[cells[i] / 64] |= 1UL << (cells[i] % 64);
+    }
+
+    SINT_64 offset = directionOffset(source, next_move.dir);
+    if (!bitboardMoveLegal(&piece_mask, next_move.piece, next_move.dir, offset, &clear, &goal))
+    {
+        return;
+    }
+
+    bitboard shifted;
+    bitboardShift(&piece_mask, offset, &shifted);
+
+    zobristMove(source, next_move.piece, offset);
+
+    // Vacate the old cells, then occupy the new ones
+    for (i = 0; i < size; ++i)
+    {
+        source->tiles[cells[i]] = CLEAR;
+    }
+    for (i = 0; i < size; ++i)
+    {
+        cells[i] += offset;
+        source->tiles[cells[i]] = next_move.piece;
+    }
+
+    for (i = 0; i < state.bitboard_words; ++i)
+    {
+        clear.bits[i] = (clear.bits[i] | piece_mask.bits[i]) & ~shifted.bits[i];
+        goal.bits[i] &= ~shifted.bits[i];
+    }
+    storeBoardMasks(source, &clear, &goal);
+}
+
+void loadBoardMasks(const board_state *source, bitboard *clear, bitboard *goal)
+{
+    UINT_64 bytes = state.bitboard_words * sizeof(UINT_64);
+    memcpy(clear->bits, BOARD_MASKS(source), bytes);
+    memcpy(goal->bits, (UINT_8 *)BOARD_MASKS(source) + bytes, bytes);
+}
+
+void storeBoardMasks(board_state *source, const bitboard *clear, const bitboard *goal)
+{
+    UINT_64 bytes = state.bitboard_words * sizeof(UINT_64);
+    memcpy(BOARD_MASKS(source), clear->bits, bytes);
+    memcpy((UINT_8 *)BOARD_MASKS(source) + bytes, goal->bits, bytes);
+}
+
+void uncoverGoal(board_state *source, UINT_64 cell)
+{
+    source->tiles[cell] = GOAL;
+    if (state.level.zobrist)
+    {
+        source->hash ^= ZOBRIST_GOAL(&state.level, cell);
+    }
+
+    if (state.bitboard_words)
+    {
+        bitboard clear;
+        bitboard goal;
+        loadBoardMasks(source, &clear, &goal);
+        clear.bits[cell / 64] &= ~(1UL << (cell % 64));
+        goal.bits[cell / 64] |= 1UL << (cell % 64);
+        storeBoardMasks(source, &clear, &goal);
+    }
+}
+
+void zobristMove(board_state *source, SINT_64 piece, SINT_64 offset)
+{
+    level_info *level = &state.level;
+    if (!source || !level->zobrist)
+    {
+        return;
+    }
+
+    UINT_64 c = pieceClass(source, piece);
+    UINT_16 *cells = PIECE_CELLS(source, piece);
+    UINT_64 i;
+    for (i = 0; i < PIECE_SIZE(source, piece); ++i)
+    {
+        source->hash ^= ZOBRIST(level, cells[i], c) ^ ZOBRIST(level, cells[i] + offset, c);
+        if (GOAL == source->tiles[cells[i] + offset])
+        {
+            source->hash ^= ZOBRIST_GOAL(level, cells[i] + offset);
+        }
+    }
+}
+
+void applyMoveCloning(board_state *source, move next_move, board_state *dest)
+{
+    if (!source || !dest)
+    {
+        return;
+    }
+
+    cloneGameState(source, dest);
+    applyMove(dest, next_move);
+}
+
+void initSearchPath(search_path *path, board_state *source)
+{
+    cloneGameState(source, &path->board);
+
+    path->size = 0;
+    path->capacity = 64;
+    path->moves = ALLOC(*path->moves, path->capacity);
+    path->goal_marks = ALLOC(*path->goal_marks, path->capacity);
+
+    path->goal_log = ALLOC(*path->goal_log, state.level.num_goals + 1);
+    path->goal_log_size = 0;
+
+    path->goals_left = 0;
+    UINT_64 i;
+    for (i = 0; i < CELLS(source); ++i)
+    {
+        if (GOAL == source->tiles[i])
+        {
+            path->goals_left++;
+        }
+    }
+}
+
+void pathApply(search_path *path, packed_move next)
+{
+    if (path->size == path->capacity)
+    {
+        path->capacity *= 2;
+        path->moves = REALLOC(path->moves, *path->moves, path->capacity);
+        path->goal_marks = REALLOC(path->goal_marks, *path->goal_marks, path->capacity);
+    }
+
+    board_state *board = &path->board;
+    move expanded = unpackMove(next);
+
+    // Log the goal cells the master is about to cover
+    path->goal_marks[path->size] = path->goal_log_size;
+    if (MASTER == expanded.piece)
+    {
+        SINT_64 offset = directionOffset(board, expanded.dir);
+        UINT_16 *cells = PIECE_CELLS(board, MASTER);
+        UINT_64 i;
+        for (i = 0; i < PIECE_SIZE(board, MASTER); ++i)
+        {
+            if (GOAL == board->tiles[cells[i] + offset])
+            {
+                path->goal_log[path->goal_log_size++] = cells[i] + offset;
+                path->goals_left--;
+            }
+        }
+    }
+
+    applyMove(board, expanded);
+    path->moves[path->size++] = next;
+}
+
+void pathUndo(search_path *path)
+{
+    if (!path->size)
+    {
+        return;
+    }
+
+    board_state *board = &path->board;
+    move expanded = unpackMove(path->moves[--path->size]);
+
+    // The cells the piece came from are free again, so the reverse move is always legal
+    expanded.dir = OPPOSITE_DIR(expanded.dir);
+    applyMove(board, expanded);
+
+    UINT_64 cell;
+    while (path->goal_log_size > path->goal_marks[path->size])
+    {
+        cell = path->goal_log[--path->goal_log_size];
+        uncoverGoal(board, cell);
+        path->goals_left++;
+    }
+}
+
+void destroy_search_path(void *p)
+{
+    search_path *path = p;
+    if (!path)
+    {
+        return;
+    }
+
+    destroy_board_state(&path->board);
+    free(path->moves);
+    free(path->goal_marks);
+    free(path->goal_log);
+}
+
+void initBreadthFrontier(breadth_frontier *frontier, board_state *source)
+{
+    sk_arena_init(&frontier->arena, SEARCH_ARENA_CHUNK);
+    frontier->count = 0;
+    frontier->head = 0;
+
+    frontier->chunk_capacity = 16;
+    frontier->parents = ALLOC(*frontier->parents, frontier->chunk_capacity);
+    frontier->moves = ALLOC(*frontier->moves, frontier->chunk_capacity);
+    frontier->depths = ALLOC(*frontier->depths, frontier->chunk_capacity);
+
+    frontier->shape = *source;
+    frontier->slot_tiles = BOARD_BUFFER_SIZE(source);
+    frontier->ring_capacity = 1024;
+    frontier->ring = ALLOC(*frontier->ring, frontier->ring_capacity * frontier->slot_tiles);
+    frontier->ring_hash = ALLOC(*frontier->ring_hash, frontier->ring_capacity);
+
+    // The root is its own parent and carries no move
+    board_state root;
+    frontierReserve(frontier, &root);
+    cloneGameStateInto(source, &root, root.tiles);
+    frontierCommit(frontier, &root, 0, 0);
+}
+
+void frontierBoard(breadth_frontier *frontier, UINT_64 i, board_state *dest)
+{
+    UINT_64 slot = i & (frontier->ring_capacity - 1);
+
+    *dest = frontier->shape;
+    dest->tiles = &frontier->ring[slot * frontier->slot_tiles];
+    dest->piece_first = (UINT_16 *)(dest->tiles + CELLS(dest));
+    dest->piece_cells = dest->piece_first + dest->max_piece + 2;
+    dest->hash = frontier->ring_hash[slot];
+}
+
+void frontierReserve(breadth_frontier *frontier, board_state *dest)
+{
+    if (frontier->count - frontier->head == frontier->ring_capacity)
+    {
+        // Move every pending board to its slot in a ring twice the size
+        UINT_64 capacity = frontier->ring_capacity * 2;
+        tile_t *ring = ALLOC(*ring, capacity * frontier->slot_tiles);
+        UINT_64 *ring_hash = ALLOC(*ring_hash, capacity);
+        UINT_64 i;
+        UINT_64 from;
+        UINT_64 to;
+        for (i = frontier->head; i < frontier->count; ++i)
+        {
+            from = i & (frontier->ring_capacity - 1);
+            to = i & (capacity - 1);
+            memcpy(&ring[to * frontier->slot_tiles],
+                   &frontier->ring[from * frontier->slot_tiles],
+                   frontier->slot_tiles * sizeof(*ring));
+            ring_hash[to] = frontier->ring_hash[from];
+        }
+
+        free(frontier->ring);
+        free(frontier->ring_hash);
+        frontier->ring = ring;
+        frontier->ring_hash = ring_hash;
+        frontier->ring_capacity = capacity;
+    }
+
+    frontierBoard(frontier, frontier->count, dest);
+}
+
+void frontierCommit(breadth_frontier *frontier, board_state *board, UINT_64 parent, packed_move next)
+{
+    UINT_64 i = frontier->count;
+    UINT_64 chunk = i >> FRONTIER_CHUNK_BITS;
+
+    // The first node of a chunk brings the chunk into existence
+    if (!(i & (FRONTIER_CHUNK - 1)))
+    {
+        if (chunk == frontier->chunk_capacity)
+        {
+            frontier->chunk_capacity *= 2;
+            frontier->parents = REALLOC(frontier->parents, *frontier->parents, frontier->chunk_capacity);
+            frontier->moves = REALLOC(frontier->moves, *frontier->moves, frontier->chunk_capacity);
+            frontier->depths = REALLOC(frontier->depths, *frontier->depths, frontier->chunk_capacity);
+        }
+        frontier->parents[chunk] = sk_arena_alloc(&frontier->arena, FRONTIER_CHUNK * sizeof(**frontier->parents));
+        frontier->moves[chunk] = sk_arena_alloc(&frontier->arena, FRONTIER_CHUNK * sizeof(**frontier->moves));
+        frontier->depths[chunk] = sk_arena_alloc(&frontier->arena, FRONTIER_CHUNK * sizeof(**frontier->depths));
+    }
+
+    FRONTIER_NODE(frontier, parents, i) = parent;
+    FRONTIER_NODE(frontier, moves, i) = next;
+    FRONTIER_NODE(frontier, depths, i) = parent == i ? 0 : FRONTIER_NODE(frontier, depths, parent) + 1;
+    frontier->ring_hash[i & (frontier->ring_capacity - 1)] = board->hash;
+    frontier->count++;
+}
+
+void destroy_breadth_frontier(void *p)
+{
+    breadth_frontier *frontier = p;
+    if (!frontier)
+    {
+        return;
+    }
+
+    sk_arena_destroy(&frontier->arena);
+    free(frontier->parents);
+    free(frontier->moves);
+    free(frontier->depths);
+    free(frontier->ring);
+    free(frontier->ring_hash);
+}
+
+bool stateEqual(const void *a, const void *b)
+{
+    const board_state *A = a;
+    const board_state *B = b;
+
+    if (!A || !B || A->width != B->width || A->height != B->height)
+    {
+        return false;
+    }
+
+    return !memcmp(A->tiles, B->tiles, CELLS(A) * sizeof(*(A->tiles)));
+}
+
+void normalizeState(board_state *source)
+{
+    if (!source)
+    {
+        return;
+    }
+
+    UINT_64 i;
+    UINT_64 cells = CELLS(source);
+    tile_t *tiles = source->tiles;
+
+    SINT_64 max = MASTER;
+    for (i = 0; i < cells; ++i)
+    {
+        if (tiles[i] > max)
+        {
+            max = tiles[i];
+        }
+    }
+
+    // remap[n] holds the new number of block n, or CLEAR until block n is first seen
+    tile_t local_remap[NORMALIZE_LOCAL_PIECES];
+    tile_t *remap = local_remap;
+    if (max >= NORMALIZE_LOCAL_PIECES)
+    {
+        remap = ALLOC(*remap, max + 1);
+    }
+    else
+    {
+        memset(remap, 0, sizeof(local_remap));
+    }
+
+    // Number blocks from 3 upwards in order of the first cell each one covers
+    tile_t current_index = 3;
+    for (i = 0; i < cells; ++i)
+    {
+        if (tiles[i] <= MASTER)
+        {
+            continue;
+        }
+        if (CLEAR == remap[tiles[i]])
+        {
+            remap[tiles[i]] = current_index++;
+        }
+        tiles[i] = remap[tiles[i]];
+    }
+
+    if (remap != local_remap)
+    {
+        free(remap);
+    }
+
+    // Piece numbers changed, so the index must follow
+    indexPieces(source);
+}
+
+void destroy_board_state(void *p)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    board_state *state = p;
+
+    // The piece index shares the tile allocation
+    free(state->tiles);
+    state->tiles = NULL;
+    state->piece_first = NULL;
+    state->piece_cells = NULL;
+}
+
+UINT_64 hashBoardState(const void *element, UINT_64 size)
+{
+    if (!element)
+    {
+        return 0;
+    }
+
+    const board_state *state = element;
+
+    // The Zobrist hash is kept current by applyMove, so no rescan is needed
+    return state->hash % size;
+}
+
+bool initLevelInfo(board_state *source, level_info *level)
+{
+    if (!source || !level)
+    {
+        return false;
+    }
+
+    memset(level, 0, sizeof(*level));
+    level->width = source->width;
+    level->height = source->height;
+    level->max_piece = source->max_piece;
+
+    UINT_64 cells = CELLS(source);
+    UINT_64 i;
+    UINT_64 row_max = 0;
+    UINT_64 col_max = 0;
+    level->row_min = source->height;
+    level->col_min = source->width;
+
+    for (i = 0; i < cells; ++i)
+    {
+        UINT_64 row = i / source->width;
+        UINT_64 col = i % source->width;
+        if (WALL != source->tiles[i])
+        {
+            level->row_min = row < level->row_min ? row : level->row_min;
+            level->col_min = col < level->col_min ? col : level->col_min;
+            row_max = row > row_max ? row : row_max;
+            col_max = col > col_max ? col : col_max;
+        }
+        if (GOAL == source->tiles[i])
+        {
+            level->num_goals++;
+        }
+    }
+
+    if (level->row_min > row_max || level->col_min > col_max)
+    {
+        return false;
+    }
+
+    level->live_width = col_max - level->col_min + 1;
+    level->live_height = row_max - level->row_min + 1;
+    level->anchor_bytes = level->live_width * level->live_height <= 256 ? 1 : 2;
+
+    level->goals = ALLOC(*(level->goals), level->num_goals + 1);
+    UINT_64 goal = 0;
+    for (i = 0; i < cells; ++i)
+    {
+        if (GOAL == source->tiles[i])
+        {
+            level->goals[goal++] = i;
+        }
+    }
+
+    SINT_64 piece;
+    for (piece = MASTER; piece <= level->max_piece; ++piece)
+    {
+        if (PIECE_SIZE(source, piece))
+        {
+            level->num_pieces++;
+        }
+        if (PIECE_SIZE(source, piece) > level->max_size)
+        {
+            level->max_size = PIECE_SIZE(source, piece);
+        }
+    }
+
+    // Group pieces into classes of identical shape. The master is always alone in class 0.
+    UINT_64 pieces = level->max_piece + 1;
+    level->class_size = ALLOC(*(level->class_size), pieces);
+    level->class_offsets = ALLOC(*(level->class_offsets), pieces * level->max_size);
+    level->class_start = ALLOC(*(level->class_start), pieces + 1);
+    UINT_64 *class_count = ALLOC(*class_count, pieces);
+
+    UINT_64 c;
+    for (piece = MASTER; piece <= level->max_piece; ++piece)
+    {
+        UINT_64 size = PIECE_SIZE(source, piece);
+        if (!size)
+        {
+            continue;
+        }
+
+        c = pieceClass(source, piece);
+        if (MASTER == piece || !c)
+        {
+            UINT_16 *cells = PIECE_CELLS(source, piece);
+            c = level->num_classes++;
+            level->class_size[c] = size;
+            for (i = 0; i < size; ++i)
+            {
+                level->class_offsets[c * level->max_size + i] = cells[i] - cells[0];
+            }
+        }
+        class_count[c]++;
+    }
+
+    for (c = 0; c < level->num_classes; ++c)
+    {
+        level->class_start[c + 1] = level->class_start[c] + class_count[c];
+    }
+    free(class_count);
+
+    if (level->max_piece > MAX_PACKED_PIECE)
+    {
+        state.printer->error(state.printer, "Error: Piece number %ld exceeds limit of %d.\n",
+                            level->max_piece, MAX_PACKED_PIECE);
+        return false;
+    }
+
+    level->key_size = KEY_HASH_BYTES
+                    + level->num_pieces * level->anchor_bytes
+                    + (level->num_goals + 7) / 8;
+
+    // Draw the Zobrist keys from a private generator so that random walks are unaffected.
+    //  Snapshots record zobristChecksum, as only a process drawing the same keys can resume one.
+    sk_random zobrist_random;
+    sk_random_default_init(&zobrist_random);
+    level->zobrist = ALLOC(*(level->zobrist), cells * (level->num_classes + 1));
+    for (i = 0; i < cells * (level->num_classes + 1); ++i)
+    {
+        level->zobrist[i] = zobrist_random.rand_64bit(&zobrist_random);
+    }
+
+    state.printer->debug(state.printer, DEBUG_DETAILS,
+                        "Level: %lu pieces in %lu shape classes, %lu byte state keys.\n",
+                        level->num_pieces,
+                        level->num_classes,
+                        level->key_size);
+
+    return true;
+}
+
+void destroy_level_info(void *p)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    level_info *level = p;
+
+    free(level->class_size);
+    free(level->class_offsets);
+    free(level->class_start);
+    free(level->goals);
+    free(level->zobrist);
+    memset(level, 0, sizeof(*level));
+}
+
+UINT_64 pieceClass(board_state *source, SINT_64 piece)
+{
+    level_info *level = &state.level;
+    if (!source || MASTER == piece || piece > source->max_piece)
+    {
+        return 0;
+    }
+
+    UINT_16 *cells = PIECE_CELLS(source, piece);
+    UINT_64 size = PIECE_SIZE(source, piece);
+    UINT_64 c, i;
+    for (c = 1; c < level->num_classes; ++c)
+    {
+        if (level->class_size[c] != size)
+        {
+            continue;
+        }
+
+        SINT_64 *offsets = &level->class_offsets[c * level->max_size];
+        for (i = 0; i < size && offsets[i] == cells[i] - cells[0]; ++i)
+        {
+            ;
+        }
+        if (i == size)
+        {
+            return c;
+        }
+    }
+    return 0;
+}
+
+UINT_64 zobristHash(board_state *source)
+{
+    level_info *level = &state.level;
+    if (!source || !level->zobrist)
+    {
+        return 0;
+    }
+
+    UINT_64 hash = 0;
+    UINT_64 i, c;
+    SINT_64 piece;
+    for (piece = MASTER; piece <= source->max_piece; ++piece)
+    {
+        UINT_16 *cells = PIECE_CELLS(source, piece);
+        c = pieceClass(source, piece);
+        for (i = 0; i < PIECE_SIZE(source, piece); ++i)
+        {
+            hash ^= ZOBRIST(level, cells[i], c);
+        }
+    }
+
+    for (i = 0; i < level->num_goals; ++i)
+    {
+        if (GOAL == source->tiles[level->goals[i]])
+        {
+            hash ^= ZOBRIST_GOAL(level, level->goals[i]);
+        }
+    }
+
+    return hash;
+}
+
+UINT_64 zobristChecksum(board_state *source)
+{
+    level_info *level = &state.level;
+    UINT_64 hash = 14695981039346656037UL;
+    UINT_64 i;
+    for (i = 0; level->zobrist && i < CELLS(source) * (level->num_classes + 1); ++i)
+    {
+        hash = (hash ^ level->zobrist[i]) * 1099511628211UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief                   Reads the anchor stored in key slot \c slot.
+ */
+UINT_64 keyAnchor(const UINT_8 *anchors, UINT_64 slot)
+{
+    const UINT_8 *at = anchors + slot * state.level.anchor_bytes;
+    return state.level.anchor_bytes > 1 ? at[0] | ((UINT_64)at[1] << 8) : at[0];
+}
+
+/**
+ * @brief                   Stores \c anchor into key slot \c slot.
+ */
+void setKeyAnchor(UINT_8 *anchors, UINT_64 slot, UINT_64 anchor)
+{
+    UINT_8 *at = anchors + slot * state.level.anchor_bytes;
+    at[0] = anchor & 0xFF;
+    if (state.level.anchor_bytes > 1)
+    {
+        at[1] = (anchor >> 8) & 0xFF;
+    }
+}
+
+void encodeStateKey(board_state *source, UINT_8 *key)
+{
+    level_info *level = &state.level;
+    if (!source || !key)
+    {
+        return;
+    }
+
+    // Number of slots filled so far in each class
+    UINT_64 local_fill[KEY_LOCAL_CLASSES] = {};
+    UINT_64 *fill = local_fill;
+    if (level->num_classes > KEY_LOCAL_CLASSES)
+    {
+        fill = ALLOC(*fill, level->num_classes);
+    }
+
+    memset(key, 0, level->key_size);
+    memcpy(key, &source->hash, KEY_HASH_BYTES);
+    UINT_8 *anchors = key + KEY_HASH_BYTES;
+
+    // Insert each anchor into its class's slots, keeping them in ascending order
+    SINT_64 piece;
+    UINT_64 i, c, slot, anchor, cell;
+    for (piece = MASTER; piece <= source->max_piece; ++piece)
+    {
+        if (!PIECE_SIZE(source, piece))
+        {
+            continue;
+        }
+
+        c = pieceClass(source, piece);
+        cell = PIECE_CELLS(source, piece)[0];
+        anchor = (cell / source->width - level->row_min) * level->live_width
+               + (cell % source->width - level->col_min);
+
+        slot = level->class_start[c] + fill[c]++;
+        while (slot > level->class_start[c] && keyAnchor(anchors, slot - 1) > anchor)
+        {
+            setKeyAnchor(anchors, slot, keyAnchor(anchors, slot - 1));
+            --slot;
+        }
+        setKeyAnchor(anchors, slot, anchor);
+    }
+
+    // Goal cells the master has not yet covered
+    UINT_8 *goal_bits = anchors + level->num_pieces * level->anchor_bytes;
+    for (i = 0; i < level->num_goals; ++i)
+    {
+        if (GOAL == source->tiles[level->goals[i]])
+        {
+            goal_bits[i / 8] |= 1 << (i % 8);
+        }
+    }
+
+    if (fill != local_fill)
+    {
+        free(fill);
+    }
+}
+
+void printSolution(sk_list *soln, UINT_64 nodes, const struct timeval *start, const struct timeval *stop)
+{
+    UINT_64 soln_size = sk_list_size(soln);
+
+    move *next_move;
+    sk_iterator it;
+    sk_list_begin(&it, soln);
+    while (it.has_next(&it))
+    {
+        next_move = it.next(&it);
+        applyMove(state.game_state, *next_move);
+        switch (next_move->dir)
+        {
+        case UP:
+            printf("(%ld, up)\n", next_move->piece);
+            break;
+        case DOWN:
+            printf("(%ld, down)\n", next_move->piece);
+            break;
+        case LEFT:
+            printf("(%ld, left)\n", next_move->piece);
+            break;
+        case RIGHT:
+            printf("(%ld, right)\n", next_move->piece);
+            break;
+        }
+
+        free(next_move);
+        sk_list_remove(&it);
+    }
+    it.destroy(&it);
+
+    printf("\n");
+    outputGameState();
+    printf("\n");
+
+    printf("Nodes Visited: %lu\n", nodes);
+    printf("Search time = %0.4f s\n",
+            (float)(stop->tv_sec - start->tv_sec + (stop->tv_usec - start->tv_usec)/(float)1000000));
+    printf("Solution Size: %lu moves\n", soln_size);
+}
+
+void printClosedStats(const sk_key_table *closed)
+{
+    state.printer->debug(state.printer, DEBUG_DETAILS,
+            "Closed Set: %lu states, load factor %0.3f, mean probe %0.3f, max probe %lu\n",
+            closed->count,
+            sk_key_table_load_factor(closed),
+            sk_key_table_mean_probe(closed),
+            closed->max_probe);
+}
+
+void randomWalks(board_state *source, UINT_64 N)
+{
+    if (!source)
+    {
+        return;
+    }
+
+    UINT_64 i;
+    UINT_64 num_moves;
+    UINT_64 move_idx;
+    packed_move packed;
+    move next_move;
+    for (i = 0; i <= N; ++i)
+    {
+        outputGameState();
+        if (i == N)
+        {
+            break;
+        }
+
+        if (gameStateSolved(source))
+        {
+            break;
+        }
+
+        num_moves = countMoves(source);
+        if (num_moves == 0)
+        {
+            printf("Error! No moves found for given board state!\n");
+            outputGameState();
+            break;
+        }
+        move_idx = state.random.rand_64bit(&state.random) % num_moves;
+
+        state.printer->debug(state.printer, DEBUG_DETAILS,
+                                "Selected move %lu / %lu\n",
+                                move_idx + 1,
+                                num_moves);
+
+        nthMove(source, move_idx, &packed);
+        next_move = unpackMove(packed);
+
+        printf("\n");
+        switch (next_move.dir)
+        {
+        case UP:
+            printf("(%ld, up)\n", next_move.piece);
+            break;
+        case DOWN:
+            printf("(%ld, down)\n", next_move.piece);
+            break;
+        case LEFT:
+            printf("(%ld, left)\n", next_move.piece);
+            break;
+        case RIGHT:
+            printf("(%ld, right)\n", next_move.piece);
+            break;
+        }
+        printf("\n");
+
+        applyMove(source, next_move);
+
+        normalizeState(source);
+    }
+
+    printf("\n");
+    printf("Random walk terminated after %lu moves.\n", i);
+
+}
+
+bool uninformedDepthFirst(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !closed || !soln)
+    {
+        return false;
+    }
+
+    struct depth_entry;
+    typedef struct depth_entry depth_entry;
+
+    // A node waiting on the open stack: the move reaching it from its parent, which
+    //      is always the node at depth - 1 of the working path when the entry is popped
+    struct depth_entry
+    {
+        packed_move next_move;
+        UINT_32 depth;
+    };
+
+    bool found = false;
+
+    search_path path;
+    initSearchPath(&path, source);
+
+    UINT_64 open_size = 0;
+    UINT_64 open_capacity = 1024;
+    depth_entry *open = ALLOC(*open, open_capacity);
+
+    if (state.checkpoint.input)
+    {
+        // Step the working path back down to where the snapshot left it, then reload the stack
+        FILE *in = state.checkpoint.input;
+        UINT_64 size = 0;
+        packed_move step;
+        bool ok = fread(&size, sizeof(size), 1, in) == 1;
+        for (; ok && size; --size)
+        {
+            ok = fread(&step, sizeof(step), 1, in) == 1;
+            if (ok)
+            {
+                pathApply(&path, step);
+            }
+        }
+        ok = ok && fread(&open_size, sizeof(open_size), 1, in) == 1;
+        if (ok && open_size > open_capacity)
+        {
+            open_capacity = open_size;
+            open = REALLOC(open, *open, open_capacity);
+        }
+        ok = ok && fread(open, sizeof(*open), open_size, in) == open_size;
+        if (!ok)
+        {
+            state.printer->error(state.printer, "Error: Failed to resume from %s.\n", state.checkpoint.resume);
+            state.checkpoint.resume_failed = true;
+            open_size = 0;
+        }
+    }
+    else
+    {
+        // The root carries no move
+        open[open_size].next_move = 0;
+        open[open_size++].depth = 0;
+        (*nodes_visited)++;
+    }
+
+    // Currently considered node
+    depth_entry current;
+    // Canonical key of the next state and its Zobrist hash
+    UINT_8 *next_key = ALLOC(*next_key, state.level.key_size);
+    UINT_64 next_hash;
+    // Moves possible in the current state
+    packed_move *moves = ALLOC(*moves, MOVE_CAPACITY(source));
+    // Number of moves possible in the current state
+    UINT_64 num_moves;
+    // Position in the move buffer
+    UINT_64 m;
+
+    FILE *out;
+    while (open_size)
+    {
+        if (checkpointDue(&state.checkpoint)
+         && (out = beginCheckpoint(&state.checkpoint, CHECKPOINT_DEPTH, source, closed, *nodes_visited)))
+        {
+            // Only the snapshot process gets here: add the working path and the open stack
+            fwrite(&path.size, sizeof(path.size), 1, out);
+            fwrite(path.moves, sizeof(*path.moves), path.size, out);
+            fwrite(&open_size, sizeof(open_size), 1, out);
+            fwrite(open, sizeof(*open), open_size, out);
+            endCheckpoint(&state.checkpoint, out);
+        }
+
+        current = open[--open_size];
+
+        // Rewind the working board to the parent, then step down to the node
+        while (path.size + 1 > current.depth && path.size)
+        {
+            pathUndo(&path);
+        }
+        if (current.depth)
+        {
+            pathApply(&path, current.next_move);
+        }
+
+        (*nodes_visited)++;
+        state.printer->debug(state.printer, DEBUG_DETAILS,
+                            "Considering:\n");
+        printGameState(&path.board);
+
+        if (!path.goals_left)
+        {
+            // Populate the solution list with the winning moves
+            for (m = 0; m < path.size; ++m)
+            {
+                move *cloned = ALLOC(*cloned, 1);
+                *cloned = unpackMove(path.moves[m]);
+                sk_list_append(soln, cloned);
+            }
+
+            found = true;
+            break;
+        }
+
+        num_moves = generateMoves(&path.board, moves, MOVE_CAPACITY(source));
+        if (num_moves == 0)
+        {
+            printf("Error! No moves found for given board state!\n");
+            break;
+        }
+
+        if (open_size + num_moves > open_capacity)
+        {
+            while (open_size + num_moves > open_capacity)
+            {
+                open_capacity *= 2;
+            }
+            open = REALLOC(open, *open, open_capacity);
+        }
+
+        // Reverse the move order for LIFO queue processing
+        for (m = num_moves; m-- > 0;)
+        {
+            pathApply(&path, moves[m]);
+            encodeStateKey(&path.board, next_key);
+            next_hash = path.board.hash;
+            pathUndo(&path);
+
+            // If we haven't visited an equivalent state yet, add its canonical
+            //      key to the closed list and the move to the open stack
+            if (sk_key_table_insert(closed, next_hash, next_key + KEY_HASH_BYTES))
+            {
+                open[open_size].next_move = moves[m];
+                open[open_size++].depth = path.size + 1;
+            }
+            else
+            {
+                state.printer->debug(state.printer, DEBUG_DETAILS,
+                                    "FOUND DUPLICATE\n");
+            }
+        }
+    }
+
+    free(next_key);
+    free(moves);
+    free(open);
+    destroy_search_path(&path);
+    return found;
+}
+
+bool uninformedBreadthFirst(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !closed || !soln)
+    {
+        return false;
+    }
+
+    // Children are checked as they are generated, so check the start itself first
+    if (gameStateSolved(source))
+    {
+        (*nodes_visited)++;
+        return true;
+    }
+
+    bool found = false;
+
+    breadth_frontier frontier;
+    initBreadthFrontier(&frontier, source);
+    if (state.checkpoint.input)
+    {
+        if (!restoreBreadthFrontier(&frontier, state.checkpoint.input))
+        {
+            state.printer->error(state.printer, "Error: Failed to resume from %s.\n", state.checkpoint.resume);
+            state.checkpoint.resume_failed = true;
+            frontier.head = frontier.count;
+        }
+    }
+    else
+    {
+        (*nodes_visited)++;
+    }
+
+    // Index of the currently considered node
+    UINT_64 current;
+    // Private copy of the current board, its ring slot may be reused by its children
+    board_state parent;
+    cloneGameState(source, &parent);
+    // View of the slot receiving the next node
+    board_state next;
+    // Canonical key of \c next to check for repeated states
+    UINT_8 *next_key = ALLOC(*next_key, state.level.key_size);
+    // Moves possible in the current state
+    packed_move *moves = ALLOC(*moves, MOVE_CAPACITY(source));
+    // Number of moves possible in the current state
+    UINT_64 num_moves;
+    // Position in the move buffer
+    UINT_64 m;
+
+    FILE *out;
+    while (!found && frontier.head < frontier.count)
+    {
+        if (checkpointDue(&state.checkpoint)
+         && (out = beginCheckpoint(&state.checkpoint, CHECKPOINT_BREADTH, source, closed, *nodes_visited)))
+        {
+            // Only the snapshot process gets here
+            saveBreadthFrontier(&frontier, out);
+            endCheckpoint(&state.checkpoint, out);
+        }
+
+        current = frontier.head;
+        frontierBoard(&frontier, current, &next);
+        memcpy(parent.tiles, next.tiles, frontier.slot_tiles * sizeof(*parent.tiles));
+        parent.hash = next.hash;
+        frontier.head++;
+
+        num_moves = generateMoves(&parent, moves, MOVE_CAPACITY(source));
+        if (num_moves == 0)
+        {
+            printf("Error! No moves found for given board state!\n");
+            break;
+        }
+
+        for (m = 0; m < num_moves; ++m)
+        {
+            frontierReserve(&frontier, &next);
+            cloneGameStateInto(&parent, &next, next.tiles);
+            applyMove(&next, unpackMove(moves[m]));
+
+            if (gameStateSolved(&next))
+            {
+                // Populate the solution list by walking back up to the root
+                UINT_32 depth = FRONTIER_NODE(&frontier, depths, current) + 1;
+                UINT_64 step = current;
+                move *cloned = ALLOC(*cloned, 1);
+                *cloned = unpackMove(moves[m]);
+                sk_list_prepend(soln, cloned);
+                while (--depth)
+                {
+                    cloned = ALLOC(*cloned, 1);
+                    *cloned = unpackMove(FRONTIER_NODE(&frontier, moves, step));
+                    sk_list_prepend(soln, cloned);
+                    step = FRONTIER_NODE(&frontier, parents, step);
+                }
+
+                found = true;
+                break;
+            }
+
+            encodeStateKey(&next, next_key);
+
+            // If we haven't visited an equivalent state yet, add its canonical
+            //      key to the closed list and the new state to the frontier
+            if (sk_key_table_insert(closed, next.hash, next_key + KEY_HASH_BYTES))
+            {
+                state.printer->debug(state.printer, DEBUG_DETAILS,
+                                    "Considering:\n");
+                printGameState(&next);
+                (*nodes_visited)++;
+
+                frontierCommit(&frontier, &next, current, moves[m]);
+            }
+            else
+            {
+                state.printer->debug(state.printer, DEBUG_DETAILS,
+                                    "FOUND DUPLICATE\n");
+            }
+        }
+    }
+
+    free(moves);
+    free(next_key);
+    destroy_board_state(&parent);
+    destroy_breadth_frontier(&frontier);
+
+    return found;
+}
+
+void initTranspositionTable(transposition_table *table, UINT_64 entries)
+{
+    memset(table, 0, sizeof(*table));
+    if (!entries)
+    {
+        return;
+    }
+
+    table->capacity = 1;
+    while (table->capacity * 2 <= entries)
+    {
+        table->capacity *= 2;
+    }
+
+    table->key_size = CLOSED_KEY_SIZE(&state.level);
+    table->fingerprints = ALLOC(*table->fingerprints, table->capacity);
+    table->depths = ALLOC(*table->depths, table->capacity);
+    table->stamps = ALLOC(*table->stamps, table->capacity);
+    table->keys = ALLOC(*table->keys, table->capacity * table->key_size + 1);
+    table->expanded = ALLOC(*table->expanded, table->capacity);
+}
+
+void beginTranspositionIteration(transposition_table *table)
+{
+    table->stamp++;
+    table->slot = ~0UL;
+    table->dropped = 0;
+}
+
+bool transpositionCutoff(transposition_table *table, search_path *path, UINT_8 *key)
+{
+    if (!table || !table->capacity)
+    {
+        return false;
+    }
+
+    // Zero marks an empty entry
+    UINT_64 fingerprint = path->board.hash ? path->board.hash : 1;
+    UINT_32 depth = path->size;
+    UINT_64 slot = ~0UL;
+    UINT_64 probe;
+    UINT_64 i;
+    bool current;
+
+    encodeStateKey(&path->board, key);
+    table->slot = ~0UL;
+
+    // The state may sit in any entry of its window. Failing that it takes an entry
+    //      not used this iteration, or else the one reached deepest.
+    for (i = 0; i < TT_PROBES; ++i)
+    {
+        probe = (fingerprint + i) & (table->capacity - 1);
+        current = table->fingerprints[probe] && table->stamps[probe] == table->stamp;
+        if (current
+         && table->fingerprints[probe] == fingerprint
+         && !memcmp(&table->keys[probe * table->key_size], key + KEY_HASH_BYTES, table->key_size))
+        {
+            if (table->depths[probe] <= depth)
+            {
+                table->cutoffs++;
+                return true;
+            }
+            table->depths[probe] = depth;
+            table->slot = probe;
+            return false;
+        }
+
+        if (slot == ~0UL || (TRANSPOSITION_CURRENT(table, slot)
+                             && (!current || table->depths[probe] > table->depths[slot])))
+        {
+            slot = probe;
+        }
+    }
+
+    current = TRANSPOSITION_CURRENT(table, slot);
+    if (current && table->depths[slot] < depth)
+    {
+        table->dropped++;
+        return false;
+    }
+
+    if (current)
+    {
+        table->replacements++;
+        table->dropped++;
+    }
+    table->slot = slot;
+    table->expanded[slot] = false;
+    table->fingerprints[slot] = fingerprint;
+    table->depths[slot] = depth;
+    table->stamps[slot] = table->stamp;
+    memcpy(&table->keys[slot * table->key_size], key + KEY_HASH_BYTES, table->key_size);
+    table->stores++;
+    return false;
+}
+
+void transpositionExpand(transposition_table *table)
+{
+    if (table && table->capacity && table->slot != ~0UL)
+    {
+        table->expanded[table->slot] = true;
+    }
+}
+
+bool transpositionComplete(const transposition_table *table)
+{
+    if (!table || !table->capacity || table->dropped)
+    {
+        return false;
+    }
+
+    UINT_64 i;
+    for (i = 0; i < table->capacity; ++i)
+    {
+        if (TRANSPOSITION_CURRENT(table, i) && !table->expanded[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printTranspositionStats(const transposition_table *table)
+{
+    printf("Transposition Table: %lu entries (%lu bytes), %lu stores, %lu replacements, %lu cutoffs\n",
+            table->capacity,
+            table->capacity * (sizeof(*table->fingerprints) + sizeof(*table->depths)
+                             + sizeof(*table->stamps) + sizeof(*table->expanded) + table->key_size),
+            table->stores,
+            table->replacements,
+            table->cutoffs);
+}
+
+void destroy_transposition_table(void *p)
+{
+    transposition_table *table = p;
+    if (!table)
+    {
+        return;
+    }
+
+    free(table->fingerprints);
+    free(table->depths);
+    free(table->stamps);
+    free(table->keys);
+    free(table->expanded);
+    table->fingerprints = NULL;
+    table->depths = NULL;
+    table->stamps = NULL;
+    table->keys = NULL;
+    table->expanded = NULL;
+    table->capacity = 0;
+}
+
+bool boundedSearch(search_path *path, UINT_64 bound, bool informed, packed_move *moves,
+                   transposition_table *table, UINT_8 *key, UINT_64 *nodes, UINT_64 *next_bound)
+{
+    (*nodes)++;
+    if (!path->goals_left)
+    {
+        return true;
+    }
+
+    UINT_64 capacity = MOVE_CAPACITY(&path->board);
+    packed_move *level_moves = &moves[path->size * capacity];
+    UINT_64 num_moves = generateMoves(&path->board, level_moves, capacity);
+    UINT_64 m;
+    UINT_64 cost;
+    SINT_64 piece;
+    for (m = 0; m < num_moves; ++m)
+    {
+        // Moves of absent pieces leave the board as it is, and undoing the
+        //      last move only leads back to the parent if it covered no goal
+        piece = MOVE_PIECE(level_moves[m]);
+        if (piece > path->board.max_piece || !PIECE_SIZE(&path->board, piece))
+        {
+            continue;
+        }
+        if (path->size && level_moves[m] == INVERSE_MOVE(path->moves[path->size - 1])
+                && path->goal_marks[path->size - 1] == path->goal_log_size)
+        {
+            continue;
+        }
+
+        pathApply(path, level_moves[m]);
+
+        // A state already reached no deeper neither needs searching nor raises the
+        //      next bound, whether or not it lies within this one
+        if (transpositionCutoff(table, path, key))
+        {
+            pathUndo(path);
+            continue;
+        }
+
+        cost = path->size + (informed ? goalEstimate(&path->board) : 0);
+        if (cost > bound)
+        {
+            if (cost < *next_bound)
+            {
+                *next_bound = cost;
+            }
+        }
+        else
+        {
+            transpositionExpand(table);
+            if (boundedSearch(path, bound, informed, moves, table, key, nodes, next_bound))
+            {
+                return true;
+            }
+        }
+
+        pathUndo(path);
+    }
+
+    return false;
+}
+
+bool iterativeDeepening(board_state *source, transposition_table *table, bool informed,
+                        sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln)
+    {
+        return false;
+    }
+
+    bool found = false;
+
+    search_path path;
+    initSearchPath(&path, source);
+
+    UINT_8 *key = ALLOC(*key, state.level.key_size);
+    UINT_64 capacity = MOVE_CAPACITY(source);
+    packed_move *moves = NULL;
+
+    UINT_64 bound = informed ? goalEstimate(source) : 0;
+    UINT_64 next_bound;
+    UINT_64 nodes;
+    while (!found)
+    {
+        // No path is longer than the bound, since the estimate is never negative
+        moves = REALLOC(moves, *moves, capacity * (bound + 1));
+
+        if (table)
+        {
+            beginTranspositionIteration(table);
+            transpositionCutoff(table, &path, key);
+            transpositionExpand(table);
+        }
+
+        nodes = 0;
+        next_bound = ~0UL;
+        found = boundedSearch(&path, bound, informed, moves, table, key, &nodes, &next_bound);
+        *nodes_visited += nodes;
+
+        printf("%s %lu: %lu nodes\n", informed ? "Cost Bound" : "Depth Limit", bound, nodes);
+
+        // Nothing was cut off, or every state reached was searched past, so the
+        //      whole reachable space has been searched
+        if (next_bound == ~0UL || transpositionComplete(table))
+        {
+            break;
+        }
+        bound = next_bound;
+    }
+
+    if (found)
+    {
+        // Populate the solution list with the winning moves
+        UINT_64 m;
+        for (m = 0; m < path.size; ++m)
+        {
+            move *cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(path.moves[m]);
+            sk_list_append(soln, cloned);
+        }
+    }
+
+    free(moves);
+    free(key);
+    destroy_search_path(&path);
+    return found;
+}
+
+UINT_64 masterGoalDistance(board_state *source)
+{
+    level_info *level = &state.level;
+    UINT_16 *cells = PIECE_CELLS(source, MASTER);
+    UINT_64 size = PIECE_SIZE(source, MASTER);
+    UINT_64 worst = 0;
+    UINT_64 nearest;
+    UINT_64 distance;
+    SINT_64 rows;
+    SINT_64 cols;
+    UINT_64 g;
+    UINT_64 i;
+
+    for (g = 0; g < level->num_goals; ++g)
+    {
+        if (source->tiles[level->goals[g]] != GOAL)
+        {
+            continue;
+        }
+
+        nearest = ~0UL;
+        for (i = 0; i < size; ++i)
+        {
+            rows = (SINT_64)(cells[i] / source->width) - (SINT_64)(level->goals[g] / source->width);
+            cols = (SINT_64)(cells[i] % source->width) - (SINT_64)(level->goals[g] % source->width);
+            distance = (rows < 0 ? -rows : rows) + (cols < 0 ? -cols : cols);
+            if (distance < nearest)
+            {
+                nearest = distance;
+            }
+        }
+
+        if (size && nearest > worst)
+        {
+            worst = nearest;
+        }
+    }
+
+    return worst;
+}
+
+bool aStar(board_state *source, sk_key_table *closed, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !closed || !soln)
+    {
+        return false;
+    }
+
+    struct astar_node;
+    typedef struct astar_node astar_node;
+
+    struct astar_node
+    {
+        board_state state;          // Tiles are released once the node has been expanded
+        astar_node *parent;         // NULL for the root
+        packed_move last_move;
+        UINT_32 depth;
+    };
+
+    bool found = false;
+
+    // Nodes stay for the parent links of their descendants until the search ends
+    sk_arena arena;
+    sk_pool node_pool;
+    sk_pool tile_pool;
+    sk_arena_init(&arena, SEARCH_ARENA_CHUNK);
+    sk_pool_init(&node_pool, &arena, sizeof(astar_node));
+    sk_pool_init(&tile_pool, &arena, BOARD_BUFFER_SIZE(source) * sizeof(tile_t));
+
+    // Open nodes by estimated solution length
+    sk_bucket_queue open;
+    sk_bucket_queue_init(&open);
+
+    astar_node *root = sk_pool_alloc(&node_pool);
+    cloneGameStateInto(source, &root->state, sk_pool_alloc(&tile_pool));
+    root->parent = NULL;
+    root->last_move = 0;
+    root->depth = 0;
+    sk_bucket_queue_push(&open, goalEstimate(&root->state), root);
+
+    // Currently considered node
+    astar_node *current;
+    // Next node to add to the open list
+    astar_node *next;
+    // Canonical key of the node being examined
+    UINT_8 *key = ALLOC(*key, state.level.key_size);
+    // Moves possible in the current state
+    packed_move *moves = ALLOC(*moves, MOVE_CAPACITY(source));
+    // Number of moves possible in the current state
+    UINT_64 num_moves;
+    // Position in the move buffer
+    UINT_64 m;
+
+    while (!found && !sk_bucket_queue_empty(&open))
+    {
+        current = sk_bucket_queue_pop(&open, NULL);
+
+        // A state may be queued more than once; only its first, shortest, expansion counts
+        encodeStateKey(&current->state, key);
+        if (!sk_key_table_insert(closed, current->state.hash, key + KEY_HASH_BYTES))
+        {
+            sk_pool_free(&tile_pool, current->state.tiles);
+            current->state.tiles = NULL;
+            continue;
+        }
+
+        (*nodes_visited)++;
+        state.printer->debug(state.printer, DEBUG_DETAILS,
+                            "Considering:\n");
+        printGameState(&current->state);
+
+        if (gameStateSolved(&current->state))
+        {
+            // Populate the solution list by walking back up to the root
+            astar_node *step;
+            for (step = current; step->parent; step = step->parent)
+            {
+                move *cloned = ALLOC(*cloned, 1);
+                *cloned = unpackMove(step->last_move);
+                sk_list_prepend(soln, cloned);
+            }
+
+            found = true;
+            break;
+        }
+
+        num_moves = generateMoves(&current->state, moves, MOVE_CAPACITY(source));
+        if (num_moves == 0)
+        {
+            printf("Error! No moves found for given board state!\n");
+            break;
+        }
+
+        for (m = 0; m < num_moves; ++m)
+        {
+            next = sk_pool_alloc(&node_pool);
+            cloneGameStateInto(&current->state, &next->state, sk_pool_alloc(&tile_pool));
+            applyMove(&next->state, unpackMove(moves[m]));
+            next->parent = current;
+            next->last_move = moves[m];
+            next->depth = current->depth + 1;
+
+            encodeStateKey(&next->state, key);
+            if (sk_key_table_contains(closed, next->state.hash, key + KEY_HASH_BYTES))
+            {
+                state.printer->debug(state.printer, DEBUG_DETAILS,
+                                    "FOUND DUPLICATE\n");
+
+                sk_pool_free(&tile_pool, next->state.tiles);
+                sk_pool_free(&node_pool, next);
+                continue;
+            }
+
+            sk_bucket_queue_push(&open, next->depth + goalEstimate(&next->state), next);
+        }
+
+        // The board of the node we just visited is no longer needed
+        sk_pool_free(&tile_pool, current->state.tiles);
+        current->state.tiles = NULL;
+    }
+
+    free(moves);
+    free(key);
+    sk_bucket_queue_destroy(&open);
+    sk_arena_destroy(&arena);
+
+    return found;
+}
+
+void seedGoalSet(goal_seeder *seeder, UINT_64 k, UINT_64 first)
+{
+    if (seeder->overflow)
+    {
+        return;
+    }
+
+    board_state *board = &seeder->board;
+
+    if (k == seeder->num_labels)
+    {
+        if (seeder->seen->count >= seeder->limit)
+        {
+            seeder->overflow = true;
+            return;
+        }
+
+        indexPieces(board);
+        board->hash = zobristHash(board);
+        encodeStateKey(board, seeder->key);
+        if (sk_key_table_put(seeder->seen, board->hash, seeder->key + KEY_HASH_BYTES, seeder->frontier->count))
+        {
+            board_state seed;
+            frontierReserve(seeder->frontier, &seed);
+            cloneGameStateInto(board, &seed, seed.tiles);
+            frontierCommit(seeder->frontier, &seed, seeder->frontier->count, 0);
+        }
+        return;
+    }
+
+    UINT_64 c = seeder->classes[k];
+    SINT_64 *rows = &seeder->rows[c * state.level.max_size];
+    SINT_64 *cols = &seeder->cols[c * state.level.max_size];
+    UINT_64 size = state.level.class_size[c];
+    SINT_64 label = seeder->labels[k];
+    UINT_64 anchor;
+    UINT_64 i;
+    SINT_64 row;
+    SINT_64 col;
+
+    for (anchor = first; anchor < CELLS(board); ++anchor)
+    {
+        for (i = 0; i < size; ++i)
+        {
+            row = (SINT_64)(anchor / board->width) + rows[i];
+            col = (SINT_64)(anchor % board->width) + cols[i];
+            if ( row < 0 || row >= (SINT_64)board->height
+              || col < 0 || col >= (SINT_64)board->width
+              || CLEAR != TILE(board, row, col)
+               )
+            {
+                break;
+            }
+        }
+        if (i < size)
+        {
+            continue;
+        }
+
+        for (i = 0; i < size; ++i)
+        {
+            TILE(board, anchor / board->width + rows[i], anchor % board->width + cols[i]) = label;
+        }
+
+        // Pieces of one class are interchangeable, so keep their anchors increasing
+        bool same_class = k + 1 < seeder->num_labels && seeder->classes[k + 1] == c;
+        seedGoalSet(seeder, k + 1, same_class ? anchor + 1 : 0);
+
+        for (i = 0; i < size; ++i)
+        {
+            TILE(board, anchor / board->width + rows[i], anchor % board->width + cols[i]) = CLEAR;
+        }
+    }
+}
+
+void seedGoalBoards(goal_seeder *seeder)
+{
+    level_info *level = &state.level;
+    board_state *board = &seeder->board;
+    UINT_64 anchor;
+    UINT_64 size = level->class_size[0];
+    SINT_64 row;
+    SINT_64 col;
+    UINT_64 covered;
+    UINT_64 g;
+    UINT_64 i;
+
+    for (anchor = 0; size && level->num_goals && anchor < CELLS(board); ++anchor)
+    {
+        covered = 0;
+        for (i = 0; i < size; ++i)
+        {
+            row = (SINT_64)(anchor / board->width) + seeder->rows[i];
+            col = (SINT_64)(anchor % board->width) + seeder->cols[i];
+            if ( row < 0 || row >= (SINT_64)board->height
+              || col < 0 || col >= (SINT_64)board->width
+              || (CLEAR != TILE(board, row, col) && GOAL != TILE(board, row, col))
+               )
+            {
+                break;
+            }
+            covered += GOAL == TILE(board, row, col);
+        }
+        if (i < size || covered < level->num_goals)
+        {
+            continue;
+        }
+
+        for (i = 0; i < size; ++i)
+        {
+            TILE(board, anchor / board->width + seeder->rows[i], anchor % board->width + seeder->cols[i]) = MASTER;
+        }
+        seedGoalSet(seeder, 0, 0);
+        for (i = 0; i < size; ++i)
+        {
+            TILE(board, anchor / board->width + seeder->rows[i], anchor % board->width + seeder->cols[i]) = GOAL;
+        }
+
+        // Cells under the master that are not goal cells were open
+        for (i = 0; i < size; ++i)
+        {
+            UINT_64 cell = (anchor / board->width + seeder->rows[i]) * board->width
+                         + anchor % board->width + seeder->cols[i];
+            for (g = 0; g < level->num_goals && level->goals[g] != cell; ++g)
+            {
+                ;
+            }
+            if (g == level->num_goals)
+            {
+                board->tiles[cell] = CLEAR;
+            }
+        }
+    }
+}
+
+bool bidirectionalSearch(board_state *source, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln)
+    {
+        return false;
+    }
+
+    level_info *level = &state.level;
+
+    // Backward moves are recorded by cell rather than by piece, in the packed move format
+    if (CELLS(source) - 1 > MAX_PACKED_PIECE)
+    {
+        state.printer->error(state.printer, "Error: Board too large for bidirectional search.\n");
+        return false;
+    }
+
+    struct search_half;
+    typedef struct search_half search_half;
+
+    // One direction of the search: its nodes, their keys and the end of the layer being expanded
+    struct search_half
+    {
+        breadth_frontier frontier;
+        sk_key_table seen;              // Maps each key to the node holding it
+        UINT_64 layer_end;
+        bool backward;
+    };
+
+    // Best meeting of the two halves found so far
+    struct
+    {
+        UINT_64 length;                 // Solution length, ~0 while none is known
+        UINT_64 forward;                // Forward node on the solution path
+        packed_move forward_step;       // Move past \c forward, if \c has_forward_step
+        bool has_forward_step;
+        UINT_64 backward;               // Backward node on the solution path, if \c has_backward
+        packed_move backward_step;      // Cell move before \c backward, if \c has_backward_step
+        bool has_backward_step;
+        bool has_backward;
+    } best;
+    memset(&best, 0, sizeof(best));
+    best.length = ~0UL;
+
+    search_half halves[2];
+    search_half *forward = &halves[0];
+    search_half *backward = &halves[1];
+    forward->backward = false;
+    backward->backward = true;
+
+    UINT_8 *key = ALLOC(*key, level->key_size);
+    UINT_64 index;
+
+    initBreadthFrontier(&forward->frontier, source);
+    sk_key_table_init_map(&forward->seen, CLOSED_KEY_SIZE(level), CLOSED_SIZE_HINT);
+    encodeStateKey(source, key);
+    sk_key_table_put(&forward->seen, source->hash, key + KEY_HASH_BYTES, 0);
+
+    // The backward half is seeded with every solved board once there are fewer of
+    //      them than nodes in the forward layer, so it starts out empty
+    goal_seeder seeder;
+    memset(&seeder, 0, sizeof(seeder));
+    cloneGameState(source, &seeder.board);
+    initBreadthFrontier(&backward->frontier, source);
+    backward->frontier.count = 0;
+    sk_key_table_init_map(&backward->seen, CLOSED_KEY_SIZE(level), CLOSED_SIZE_HINT);
+    seeder.frontier = &backward->frontier;
+    seeder.seen = &backward->seen;
+    seeder.key = key;
+
+    UINT_64 pieces = level->max_piece + 1;
+    seeder.labels = ALLOC(*seeder.labels, pieces);
+    seeder.classes = ALLOC(*seeder.classes, pieces);
+    seeder.rows = ALLOC(*seeder.rows, level->num_classes * level->max_size);
+    seeder.cols = ALLOC(*seeder.cols, level->num_classes * level->max_size);
+
+    bool *shaped = ALLOC(*shaped, level->num_classes);
+    SINT_64 piece;
+    UINT_64 c;
+    UINT_64 i;
+    for (c = 0; c < level->num_classes; ++c)
+    {
+        for (piece = MASTER; piece <= source->max_piece; ++piece)
+        {
+            if (!PIECE_SIZE(source, piece) || pieceClass(source, piece) != c)
+            {
+                continue;
+            }
+
+            if (!shaped[c])
+            {
+                UINT_16 *cells = PIECE_CELLS(source, piece);
+                for (i = 0; i < PIECE_SIZE(source, piece); ++i)
+                {
+                    seeder.rows[c * level->max_size + i] = (SINT_64)(cells[i] / source->width)
+                                                         - (SINT_64)(cells[0] / source->width);
+                    seeder.cols[c * level->max_size + i] = (SINT_64)(cells[i] % source->width)
+                                                         - (SINT_64)(cells[0] % source->width);
+                }
+                shaped[c] = true;
+            }
+
+            if (MASTER != piece)
+            {
+                seeder.labels[seeder.num_labels] = piece;
+                seeder.classes[seeder.num_labels++] = c;
+            }
+        }
+    }
+    free(shaped);
+
+    // Empty the board down to its walls and goal cells
+    board_state *board = &seeder.board;
+    for (i = 0; i < CELLS(board); ++i)
+    {
+        if (board->tiles[i] >= MASTER)
+        {
+            board->tiles[i] = CLEAR;
+        }
+    }
+
+    UINT_64 goal_set = 0;
+    UINT_64 next_seeding = 1;           // Forward layer size to try seeding at, 0 once given up
+
+    forward->layer_end = forward->frontier.count;
+    backward->layer_end = 0;
+
+    // Forward nodes are checked for being solved as they are generated, so no
+    //      seed can be among the forward nodes of earlier layers
+    if (gameStateSolved(source))
+    {
+        best.length = 0;
+    }
+
+    // Private copy of the node being expanded, its ring slot may be reused by its children
+    board_state parent;
+    cloneGameState(source, &parent);
+    board_state next;
+    packed_move *moves = ALLOC(*moves, MOVE_CAPACITY(source));
+    UINT_64 num_moves;
+    UINT_64 m;
+    UINT_64 current;
+    UINT_64 depth;
+    move expanded;
+    search_half *half;
+    search_half *other;
+    UINT_64 pending[2];
+    UINT_64 g;
+
+    while (best.length == ~0UL)
+    {
+        pending[0] = forward->layer_end - forward->frontier.head;
+        if (!pending[0])
+        {
+            break;
+        }
+
+        // Try seeding the backward half, accepting at most as many solved boards as the
+        //      forward layer holds. A failed try is retried once the layer has doubled,
+        //      so the tries cost no more than the forward search itself.
+        if (!goal_set && next_seeding && pending[0] >= next_seeding)
+        {
+            seeder.limit = pending[0] < GOAL_SEED_LIMIT ? pending[0] : GOAL_SEED_LIMIT;
+            seeder.overflow = false;
+            seedGoalBoards(&seeder);
+            if (!seeder.overflow)
+            {
+                goal_set = backward->frontier.count;
+                backward->layer_end = goal_set;
+            }
+            else
+            {
+                destroy_breadth_frontier(&backward->frontier);
+                initBreadthFrontier(&backward->frontier, source);
+                backward->frontier.count = 0;
+                sk_key_table_destroy(&backward->seen);
+                sk_key_table_init_map(&backward->seen, CLOSED_KEY_SIZE(level), CLOSED_SIZE_HINT);
+
+                if (seeder.limit == GOAL_SEED_LIMIT)
+                {
+                    // Too many solved boards to hold: search forward only
+                    state.printer->debug(state.printer, DEBUG_DETAILS,
+                                         "Goal set exceeds %lu states, searching forward only.\n",
+                                         seeder.limit);
+                    next_seeding = 0;
+                }
+                else
+                {
+                    next_seeding = 2 * pending[0];
+                }
+            }
+        }
+        pending[1] = backward->layer_end - backward->frontier.head;
+
+        // Grow the half with the smaller layer
+        half = pending[1] && pending[1] < pending[0] ? backward : forward;
+        other = half == forward ? backward : forward;
+
+        while (half->frontier.head < half->layer_end)
+        {
+            current = half->frontier.head;
+            frontierBoard(&half->frontier, current, &next);
+            memcpy(parent.tiles, next.tiles, half->frontier.slot_tiles * sizeof(*parent.tiles));
+            parent.hash = next.hash;
+            half->frontier.head++;
+            depth = FRONTIER_NODE(&half->frontier, depths, current) + 1;
+
+            num_moves = generateMoves(&parent, moves, MOVE_CAPACITY(source));
+            for (m = 0; m < num_moves; ++m)
+            {
+                expanded = unpackMove(moves[m]);
+                if (expanded.piece > parent.max_piece || !PIECE_SIZE(&parent, expanded.piece))
+                {
+                    continue;
+                }
+
+                // Backwards the master may not step onto a goal cell: undone, that
+                //      move would take the master off it
+                if (half->backward && MASTER == expanded.piece)
+                {
+                    SINT_64 offset = directionOffset(&parent, expanded.dir);
+                    UINT_16 *cells = PIECE_CELLS(&parent, MASTER);
+                    for (i = 0; i < PIECE_SIZE(&parent, MASTER)
+                             && cellStepOnBoard(&parent, cells[i], expanded.dir)
+                             && GOAL != parent.tiles[cells[i] + offset]; ++i)
+                    {
+                        ;
+                    }
+                    if (i < PIECE_SIZE(&parent, MASTER))
+                    {
+                        continue;
+                    }
+                }
+
+                frontierReserve(&half->frontier, &next);
+                cloneGameStateInto(&parent, &next, next.tiles);
+                applyMove(&next, expanded);
+
+                if (half->backward && MASTER == expanded.piece)
+                {
+                    // Goal cells the master backs off are uncovered again
+                    for (g = 0; g < level->num_goals; ++g)
+                    {
+                        if (CLEAR == next.tiles[level->goals[g]])
+                        {
+                            uncoverGoal(&next, level->goals[g]);
+                        }
+                    }
+                }
+
+                if (!half->backward && gameStateSolved(&next) && depth < best.length)
+                {
+                    best.length = depth;
+                    best.forward = current;
+                    best.forward_step = moves[m];
+                    best.has_forward_step = true;
+                    best.has_backward = false;
+                    best.has_backward_step = false;
+                }
+
+                encodeStateKey(&next, key);
+                if (!sk_key_table_put(&half->seen, next.hash, key + KEY_HASH_BYTES, half->frontier.count))
+                {
+                    continue;
+                }
+
+                // Forward moves record the piece moved; backward moves the cell the piece
+                //      ends on and the direction that takes it back
+                packed_move step = moves[m];
+                if (half->backward)
+                {
+                    step = PACK_MOVE((packed_move)PIECE_CELLS(&next, expanded.piece)[0],
+                                     OPPOSITE_DIR(expanded.dir));
+                }
+
+                if (sk_key_table_get(&other->seen, next.hash, key + KEY_HASH_BYTES, &index))
+                {
+                    UINT_64 length = depth + FRONTIER_NODE(&other->frontier, depths, index);
+                    if (length < best.length)
+                    {
+                        best.length = length;
+                        if (half->backward)
+                        {
+                            best.forward = index;
+                            best.has_forward_step = false;
+                            best.backward = current;
+                            best.backward_step = step;
+                            best.has_backward_step = true;
+                        }
+                        else
+                        {
+                            best.forward = current;
+                            best.forward_step = step;
+                            best.has_forward_step = true;
+                            best.backward = index;
+                            best.has_backward_step = false;
+                        }
+                        best.has_backward = true;
+                    }
+                }
+
+                frontierCommit(&half->frontier, &next, current, step);
+            }
+        }
+        half->layer_end = half->frontier.count;
+    }
+
+    *nodes_visited += forward->frontier.count + backward->frontier.count;
+    state.printer->debug(state.printer, DEBUG_DETAILS,
+                         "Forward Nodes: %lu, Backward Nodes: %lu, Goal Set: %lu states\n",
+                         forward->frontier.count, backward->frontier.count, goal_set);
+
+    bool found = best.length != ~0UL;
+    if (found)
+    {
+        // Forward part: walk back from the meeting node to the start
+        UINT_64 step;
+        move *cloned;
+        if (best.has_forward_step)
+        {
+            cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(best.forward_step);
+            sk_list_prepend(soln, cloned);
+        }
+        for (step = best.forward; FRONTIER_NODE(&forward->frontier, parents, step) != step;
+             step = FRONTIER_NODE(&forward->frontier, parents, step))
+        {
+            cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(FRONTIER_NODE(&forward->frontier, moves, step));
+            sk_list_prepend(soln, cloned);
+        }
+
+        // Backward part: replay on the real board to name the piece at each recorded cell
+        board_state replay;
+        cloneGameState(source, &replay);
+        sk_iterator it;
+        sk_list_begin(&it, soln);
+        while (it.has_next(&it))
+        {
+            applyMove(&replay, *(move *)it.next(&it));
+        }
+        it.destroy(&it);
+
+        bool pending_step = best.has_backward_step;
+        step = best.backward;
+        while (best.has_backward && (pending_step || FRONTIER_NODE(&backward->frontier, depths, step)))
+        {
+            packed_move cell_move = pending_step ? best.backward_step
+                                                 : FRONTIER_NODE(&backward->frontier, moves, step);
+            cloned = ALLOC(*cloned, 1);
+            cloned->piece = replay.tiles[MOVE_PIECE(cell_move)];
+            cloned->dir = MOVE_DIR(cell_move);
+            sk_list_append(soln, cloned);
+            applyMove(&replay, *cloned);
+
+            if (!pending_step)
+            {
+                step = FRONTIER_NODE(&backward->frontier, parents, step);
+            }
+            pending_step = false;
+        }
+        destroy_board_state(&replay);
+    }
+
+    free(seeder.labels);
+    free(seeder.classes);
+    free(seeder.rows);
+    free(seeder.cols);
+    destroy_board_state(&seeder.board);
+
+    free(moves);
+    free(key);
+    destroy_board_state(&parent);
+    for (i = 0; i < 2; ++i)
+    {
+        destroy_breadth_frontier(&halves[i].frontier);
+        sk_key_table_destroy(&halves[i].seen);
+    }
+
+    return found;
+}
+
+void layerWorkerRun(layer_worker *worker)
+{
+    parallel_breadth *search = worker->search;
+    breadth_frontier *frontier = &search->frontier;
+    UINT_64 threads = search->num_threads;
+    UINT_64 key_size = CLOSED_KEY_SIZE(&state.level);
+    UINT_64 capacity = MOVE_CAPACITY(&frontier->shape);
+
+    board_state parent;
+    board_state child;
+    layer_worker *other;
+    UINT_64 current;
+    UINT_64 first;
+    UINT_64 last;
+    UINT_64 num_moves;
+    UINT_64 index;
+    UINT_64 m;
+    UINT_64 w;
+    UINT_64 i;
+
+    while (true)
+    {
+        if (0 == worker->id)
+        {
+            frontier->head = search->layer_end;
+            search->layer_end = frontier->count;
+            search->done = frontier->head == frontier->count;
+        }
+        pthread_barrier_wait(&search->barrier);
+        if (search->done)
+        {
+            break;
+        }
+
+        // Expand this worker's share of the layer
+        first = frontier->head + (search->layer_end - frontier->head) * worker->id / threads;
+        last = frontier->head + (search->layer_end - frontier->head) * (worker->id + 1) / threads;
+        worker->count = 0;
+        worker->solved = ~0UL;
+        for (current = first; current < last && worker->solved == ~0UL; ++current)
+        {
+            frontierBoard(frontier, current, &parent);
+            num_moves = generateMoves(&parent, worker->moves, capacity);
+            for (m = 0; m < num_moves; ++m)
+            {
+                cloneGameStateInto(&parent, &worker->next, worker->next.tiles);
+                applyMove(&worker->next, unpackMove(worker->moves[m]));
+
+                if (worker->count == worker->capacity)
+                {
+                    worker->capacity *= 2;
+                    worker->parents = REALLOC(worker->parents, *worker->parents, worker->capacity);
+                    worker->steps = REALLOC(worker->steps, *worker->steps, worker->capacity);
+                    worker->hashes = REALLOC(worker->hashes, *worker->hashes, worker->capacity);
+                    worker->keys = REALLOC(worker->keys, *worker->keys, worker->capacity * key_size);
+                    worker->fresh = REALLOC(worker->fresh, *worker->fresh, worker->capacity);
+                }
+
+                worker->parents[worker->count] = current;
+                worker->steps[worker->count] = worker->moves[m];
+
+                // Children after a solution are never needed
+                if (gameStateSolved(&worker->next))
+                {
+                    worker->solved = worker->count++;
+                    break;
+                }
+
+                encodeStateKey(&worker->next, worker->key);
+                worker->hashes[worker->count] = worker->next.hash;
+                memcpy(&worker->keys[worker->count * key_size], worker->key + KEY_HASH_BYTES, key_size);
+                worker->fresh[worker->count] = false;
+                worker->count++;
+            }
+        }
+        pthread_barrier_wait(&search->barrier);
+
+        // The first solution in layer order ends the search
+        for (w = 0; w < threads && search->workers[w].solved == ~0UL; ++w)
+        {
+            ;
+        }
+        if (w < threads)
+        {
+            if (0 == worker->id)
+            {
+                other = &search->workers[w];
+                search->found = true;
+                search->solved_parent = other->parents[other->solved];
+                search->solved_move = other->steps[other->solved];
+            }
+            break;
+        }
+
+        // Settle the children hashing to this worker's shard, in layer order so that the
+        //      first of several equal children is the one kept
+        for (w = 0; w < threads; ++w)
+        {
+            other = &search->workers[w];
+            for (i = 0; i < other->count; ++i)
+            {
+                if (CLOSED_SHARD(other->hashes[i], threads) == worker->id)
+                {
+                    other->fresh[i] = sk_key_table_insert(&search->shards[worker->id], other->hashes[i],
+                                                          &other->keys[i * key_size]);
+                }
+            }
+        }
+        pthread_barrier_wait(&search->barrier);
+
+        // Number the new children in layer order. Their boards are built in parallel next,
+        //      the layer's boards stay in the ring until then.
+        if (0 == worker->id)
+        {
+            for (w = 0; w < threads; ++w)
+            {
+                other = &search->workers[w];
+                other->first_index = frontier->count;
+                for (i = 0; i < other->count; ++i)
+                {
+                    if (other->fresh[i])
+                    {
+                        frontierReserve(frontier, &child);
+                        child.hash = other->hashes[i];
+                        frontierCommit(frontier, &child, other->parents[i], other->steps[i]);
+                    }
+                }
+            }
+        }
+        pthread_barrier_wait(&search->barrier);
+
+        index = worker->first_index;
+        for (i = 0; i < worker->count; ++i)
+        {
+            if (worker->fresh[i])
+            {
+                frontierBoard(frontier, worker->parents[i], &parent);
+                frontierBoard(frontier, index++, &child);
+                cloneGameStateInto(&parent, &child, child.tiles);
+                applyMove(&child, unpackMove(worker->steps[i]));
+            }
+        }
+        pthread_barrier_wait(&search->barrier);
+    }
+}
+
+void *layerWorkerMain(void *p)
+{
+    layerWorkerRun(p);
+    return NULL;
+}
+
+bool parallelBreadthFirst(board_state *source, UINT_64 threads, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln || !threads)
+    {
+        return false;
+    }
+
+    // Only generated boards are checked, so a solved start is caught here
+    if (gameStateSolved(source))
+    {
+        (*nodes_visited)++;
+        return true;
+    }
+
+    parallel_breadth search;
+    memset(&search, 0, sizeof(search));
+    initBreadthFrontier(&search.frontier, source);
+    search.num_threads = threads;
+    search.workers = ALLOC(*search.workers, threads);
+    search.shards = ALLOC(*search.shards, threads);
+    pthread_barrier_init(&search.barrier, NULL, threads);
+
+    UINT_64 key_size = CLOSED_KEY_SIZE(&state.level);
+    UINT_64 i;
+    layer_worker *worker;
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        memset(worker, 0, sizeof(*worker));
+        worker->search = &search;
+        worker->id = i;
+        cloneGameState(source, &worker->next);
+        worker->moves = ALLOC(*worker->moves, MOVE_CAPACITY(source));
+        worker->key = ALLOC(*worker->key, state.level.key_size);
+        worker->capacity = 1024;
+        worker->parents = ALLOC(*worker->parents, worker->capacity);
+        worker->steps = ALLOC(*worker->steps, worker->capacity);
+        worker->hashes = ALLOC(*worker->hashes, worker->capacity);
+        worker->keys = ALLOC(*worker->keys, worker->capacity * key_size);
+        worker->fresh = ALLOC(*worker->fresh, worker->capacity);
+        sk_key_table_init(&search.shards[i], key_size, CLOSED_SIZE_HINT / threads + 1);
+    }
+
+    // The calling thread is worker 0
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_create(&search.workers[i].thread, NULL, layerWorkerMain, &search.workers[i]);
+    }
+    layerWorkerRun(&search.workers[0]);
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_join(search.workers[i].thread, NULL);
+    }
+
+    *nodes_visited += search.frontier.count;
+
+    if (search.found)
+    {
+        // Populate the solution list by walking back up to the root
+        breadth_frontier *frontier = &search.frontier;
+        UINT_64 step = search.solved_parent;
+        move *cloned = ALLOC(*cloned, 1);
+        *cloned = unpackMove(search.solved_move);
+        sk_list_prepend(soln, cloned);
+        for (; FRONTIER_NODE(frontier, parents, step) != step; step = FRONTIER_NODE(frontier, parents, step))
+        {
+            cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(FRONTIER_NODE(frontier, moves, step));
+            sk_list_prepend(soln, cloned);
+        }
+    }
+
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        destroy_board_state(&worker->next);
+        free(worker->moves);
+        free(worker->key);
+        free(worker->parents);
+        free(worker->steps);
+        free(worker->hashes);
+        free(worker->keys);
+        free(worker->fresh);
+        sk_key_table_destroy(&search.shards[i]);
+    }
+    pthread_barrier_destroy(&search.barrier);
+    free(search.workers);
+    free(search.shards);
+    destroy_breadth_frontier(&search.frontier);
+
+    return search.found;
+}
+
+void hdaReceive(hda_worker *worker, hda_node *node)
+{
+    hda_search *search = worker->search;
+    UINT_64 estimate = node->depth + goalEstimate(&node->state);
+    UINT_64 value;
+    hda_node *known;
+
+    // With an admissible estimate nothing past the best solution can improve on it
+    if (estimate >= atomic_load(&search->incumbent))
+    {
+        destroy_board_state(&node->state);
+        free(node);
+        return;
+    }
+
+    encodeStateKey(&node->state, worker->key);
+    if (sk_key_table_get(&worker->closed, node->state.hash, worker->key + KEY_HASH_BYTES, &value))
+    {
+        known = (hda_node *)(uintptr_t)value;
+        if (known->depth <= node->depth)
+        {
+            destroy_board_state(&node->state);
+            free(node);
+            return;
+        }
+
+        // Reached by a shorter path: reopen the state under the new node
+        known->superseded = true;
+    }
+    sk_key_table_set(&worker->closed, node->state.hash, worker->key + KEY_HASH_BYTES, (uintptr_t)node);
+    node->owned = worker->owned;
+    worker->owned = node;
+
+    if (gameStateSolved(&node->state))
+    {
+        UINT_64 incumbent = atomic_load(&search->incumbent);
+        while (node->depth < incumbent
+            && !atomic_compare_exchange_weak(&search->incumbent, &incumbent, node->depth))
+        {
+            ;
+        }
+        if (!worker->best || node->depth < worker->best->depth)
+        {
+            worker->best = node;
+        }
+        destroy_board_state(&node->state);
+        return;
+    }
+
+    sk_bucket_queue_push(&worker->open, estimate, node);
+}
+
+void hdaWorkerRun(hda_worker *worker)
+{
+    hda_search *search = worker->search;
+    UINT_64 capacity = MOVE_CAPACITY(state.game_state);
+    UINT_64 estimate;
+    UINT_64 num_moves;
+    UINT_64 owner;
+    UINT_64 m;
+    sk_mail *mail;
+    sk_mail *next_mail;
+    hda_node *current;
+    hda_node *next;
+
+    while (true)
+    {
+        // A worker receiving a node has work again. It counts itself before the
+        //      message stops counting, so the outstanding work never reads zero in between.
+        for (mail = sk_mailbox_collect(&worker->inbox); mail; mail = next_mail)
+        {
+            next_mail = mail->next;
+            if (!worker->busy)
+            {
+                atomic_fetch_add(&search->outstanding, 1);
+                worker->busy = true;
+            }
+            hdaReceive(worker, (hda_node *)mail);
+            atomic_fetch_sub(&search->outstanding, 1);
+        }
+
+        // Discard superseded nodes and those that cannot beat the best solution
+        current = NULL;
+        while (!current && !sk_bucket_queue_empty(&worker->open))
+        {
+            current = sk_bucket_queue_pop(&worker->open, &estimate);
+            if (current->superseded || estimate >= atomic_load(&search->incumbent))
+            {
+                destroy_board_state(&current->state);
+                current = NULL;
+            }
+        }
+
+        if (!current)
+        {
+            if (worker->busy)
+            {
+                worker->busy = false;
+                atomic_fetch_sub(&search->outstanding, 1);
+            }
+            if (!atomic_load(&search->outstanding))
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        worker->expanded++;
+        num_moves = generateMoves(&current->state, worker->moves, capacity);
+        for (m = 0; m < num_moves; ++m)
+        {
+            next = ALLOC(*next, 1);
+            cloneGameState(&current->state, &next->state);
+            applyMove(&next->state, unpackMove(worker->moves[m]));
+            next->parent = current;
+            next->owned = NULL;
+            next->last_move = worker->moves[m];
+            next->depth = current->depth + 1;
+            next->superseded = false;
+
+            owner = CLOSED_SHARD(next->state.hash, search->num_threads);
+            if (owner == worker->id)
+            {
+                hdaReceive(worker, next);
+            }
+            else
+            {
+                atomic_fetch_add(&search->outstanding, 1);
+                sk_mailbox_post(&search->workers[owner].inbox, &next->mail);
+            }
+        }
+
+        // The board of the node we just expanded is no longer needed
+        destroy_board_state(&current->state);
+    }
+}
+
+void *hdaWorkerMain(void *p)
+{
+    hdaWorkerRun(p);
+    return NULL;
+}
+
+bool hashDistributedAStar(board_state *source, UINT_64 threads, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln || !threads)
+    {
+        return false;
+    }
+
+    hda_search search;
+    search.num_threads = threads;
+    search.workers = ALLOC(*search.workers, threads);
+    atomic_init(&search.incumbent, ~0UL);
+
+    UINT_64 i;
+    hda_worker *worker;
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        memset(worker, 0, sizeof(*worker));
+        worker->search = &search;
+        worker->id = i;
+        sk_mailbox_init(&worker->inbox);
+        sk_bucket_queue_init(&worker->open);
+        sk_key_table_init_map(&worker->closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT / threads + 1);
+        worker->key = ALLOC(*worker->key, state.level.key_size);
+        worker->moves = ALLOC(*worker->moves, MOVE_CAPACITY(source));
+    }
+
+    // The root is the only outstanding work to begin with
+    hda_node *root = ALLOC(*root, 1);
+    cloneGameState(source, &root->state);
+    root->parent = NULL;
+    root->owned = NULL;
+    root->last_move = 0;
+    root->depth = 0;
+    root->superseded = false;
+    atomic_init(&search.outstanding, 1);
+    sk_mailbox_post(&search.workers[CLOSED_SHARD(root->state.hash, threads)].inbox, &root->mail);
+
+    // The calling thread is worker 0
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_create(&search.workers[i].thread, NULL, hdaWorkerMain, &search.workers[i]);
+    }
+    hdaWorkerRun(&search.workers[0]);
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_join(search.workers[i].thread, NULL);
+    }
+
+    hda_node *best = NULL;
+    printf("Worker Expansions:");
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        printf(" %lu", worker->expanded);
+        *nodes_visited += worker->expanded;
+        if (worker->best && (!best || worker->best->depth < best->depth))
+        {
+            best = worker->best;
+        }
+    }
+    printf("\n");
+
+    // Populate the solution list by walking back up to the root
+    hda_node *step;
+    for (step = best; step && step->parent; step = step->parent)
+    {
+        move *cloned = ALLOC(*cloned, 1);
+        *cloned = unpackMove(step->last_move);
+        sk_list_prepend(soln, cloned);
+    }
+
+    hda_node *node;
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        while (worker->owned)
+        {
+            node = worker->owned;
+            worker->owned = node->owned;
+            destroy_board_state(&node->state);
+            free(node);
+        }
+        sk_bucket_queue_destroy(&worker->open);
+        sk_key_table_destroy(&worker->closed);
+        free(worker->key);
+        free(worker->moves);
+    }
+    free(search.workers);
+
+    return best != NULL;
+}
+
+void serveStealRequest(stealing_worker *worker)
+{
+    SINT_64 id = atomic_load(&worker->request);
+    if (id < 0)
+    {
+        return;
+    }
+
+    stealing_search *search = worker->search;
+    stealing_worker *thief = &search->workers[id];
+    if (worker->open_base < worker->open_size)
+    {
+        // Every pending entry descends from the working path, so the moves of its
+        //      parent are a prefix of that path
+        thief->loot = worker->open[worker->open_base++];
+        UINT_64 prefix = thief->loot.depth ? thief->loot.depth - 1 : 0;
+        if (prefix > thief->loot_capacity)
+        {
+            thief->loot_capacity = prefix;
+            thief->loot_path = REALLOC(thief->loot_path, *thief->loot_path, thief->loot_capacity);
+        }
+        memcpy(thief->loot_path, worker->path.moves, prefix * sizeof(*thief->loot_path));
+
+        // The thief is busy again before this worker can go idle
+        atomic_fetch_sub(&search->idle, 1);
+        atomic_store(&thief->response, STEAL_GRANTED);
+    }
+    else
+    {
+        atomic_store(&thief->response, STEAL_DENIED);
+    }
+    atomic_store(&worker->request, -1);
+}
+
+bool stealWork(stealing_worker *worker)
+{
+    stealing_search *search = worker->search;
+    UINT_64 victim = worker->id;
+    SINT_64 none;
+    int response;
+
+    atomic_fetch_add(&search->idle, 1);
+    while (!atomic_load(&search->stop) && atomic_load(&search->idle) < search->num_threads)
+    {
+        serveStealRequest(worker);
+
+        victim = (victim + 1) % search->num_threads;
+        if (victim == worker->id)
+        {
+            sched_yield();
+            continue;
+        }
+
+        atomic_store(&worker->response, STEAL_WAITING);
+        none = -1;
+        if (!atomic_compare_exchange_strong(&search->workers[victim].request, &none, (SINT_64)worker->id))
+        {
+            continue;
+        }
+
+        // Keep answering others while waiting, or two idle workers could wait on each other
+        while (STEAL_WAITING == (response = atomic_load(&worker->response)))
+        {
+            if (atomic_load(&search->stop) || atomic_load(&search->idle) == search->num_threads)
+            {
+                return false;
+            }
+            serveStealRequest(worker);
+            sched_yield();
+        }
+
+        if (STEAL_GRANTED == response)
+        {
+            UINT_64 prefix = worker->loot.depth ? worker->loot.depth - 1 : 0;
+            UINT_64 i;
+            while (worker->path.size)
+            {
+                pathUndo(&worker->path);
+            }
+            for (i = 0; i < prefix; ++i)
+            {
+                pathApply(&worker->path, worker->loot_path[i]);
+            }
+
+            worker->open_base = 0;
+            worker->open_size = 0;
+            worker->open[worker->open_size++] = worker->loot;
+            worker->steals++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void stealingWorkerRun(stealing_worker *worker)
+{
+    stealing_search *search = worker->search;
+    search_path *path = &worker->path;
+    UINT_64 capacity = MOVE_CAPACITY(state.game_state);
+
+    // Currently considered node
+    depth_entry current;
+    UINT_64 next_hash;
+    UINT_64 num_moves;
+    UINT_64 m;
+    int inserted;
+
+    while (!atomic_load(&search->stop))
+    {
+        if (worker->open_base == worker->open_size)
+        {
+            if (!stealWork(worker))
+            {
+                break;
+            }
+            continue;
+        }
+
+        current = worker->open[--worker->open_size];
+
+        // Rewind the working board to the parent, then step down to the node
+        while (path->size + 1 > current.depth && path->size)
+        {
+            pathUndo(path);
+        }
+        if (current.depth)
+        {
+            pathApply(path, current.next_move);
+        }
+        worker->nodes++;
+
+        // Only entries besides the node in hand are given away, so work cannot bounce
+        //      between workers without being expanded
+        serveStealRequest(worker);
+
+        if (!path->goals_left)
+        {
+            if (!atomic_exchange(&search->stop, true))
+            {
+                search->found = true;
+                search->winner = worker->id;
+            }
+            break;
+        }
+
+        num_moves = generateMoves(&path->board, worker->moves, capacity);
+        if (num_moves == 0)
+        {
+            // Ends the search, as it does the depth first search
+            if (!atomic_exchange(&search->stop, true))
+            {
+                search->stuck = true;
+            }
+            break;
+        }
+
+        // Entries below the base were handed out, so room is made by shifting them off
+        if (worker->open_size + num_moves > worker->open_capacity)
+        {
+            memmove(worker->open, &worker->open[worker->open_base],
+                    (worker->open_size - worker->open_base) * sizeof(*worker->open));
+            worker->open_size -= worker->open_base;
+            worker->open_base = 0;
+            while (worker->open_size + num_moves > worker->open_capacity)
+            {
+                worker->open_capacity *= 2;
+            }
+            worker->open = REALLOC(worker->open, *worker->open, worker->open_capacity);
+        }
+
+        // Reverse the move order for LIFO queue processing
+        for (m = num_moves; m-- > 0;)
+        {
+            pathApply(path, worker->moves[m]);
+            encodeStateKey(&path->board, worker->key);
+            next_hash = path->board.hash;
+            pathUndo(path);
+
+            inserted = sk_atomic_key_set_insert(&search->closed, next_hash, worker->key + KEY_HASH_BYTES);
+            if (SK_KEY_SET_INSERTED == inserted)
+            {
+                worker->open[worker->open_size].next_move = worker->moves[m];
+                worker->open[worker->open_size++].depth = path->size + 1;
+            }
+            else if (SK_KEY_SET_FULL == inserted)
+            {
+                // Without room to record states the search could loop forever
+                atomic_store(&search->stop, true);
+                break;
+            }
+        }
+    }
+}
+
+void *stealingWorkerMain(void *p)
+{
+    stealingWorkerRun(p);
+    return NULL;
+}
+
+bool stealingDepthFirst(board_state *source, UINT_64 threads, UINT_64 entries, sk_list *soln,
+                        UINT_64 *nodes_visited)
+{
+    if (!source || !soln || !threads)
+    {
+        return false;
+    }
+
+    stealing_search search;
+    if (!sk_atomic_key_set_init(&search.closed, CLOSED_KEY_SIZE(&state.level), entries))
+    {
+        state.printer->error(state.printer, "Error: Failed to allocate a closed set of %lu entries.\n", entries);
+        return false;
+    }
+    search.num_threads = threads;
+    search.workers = ALLOC(*search.workers, threads);
+    search.found = false;
+    search.stuck = false;
+    search.winner = 0;
+    atomic_init(&search.stop, false);
+
+    // Workers count themselves idle once they look for work
+    atomic_init(&search.idle, 0);
+
+    UINT_64 i;
+    stealing_worker *worker;
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        memset(worker, 0, sizeof(*worker));
+        worker->search = &search;
+        worker->id = i;
+        initSearchPath(&worker->path, source);
+        worker->open_capacity = 1024;
+        worker->open = ALLOC(*worker->open, worker->open_capacity);
+        worker->key = ALLOC(*worker->key, state.level.key_size);
+        worker->moves = ALLOC(*worker->moves, MOVE_CAPACITY(source));
+        worker->loot_capacity = 64;
+        worker->loot_path = ALLOC(*worker->loot_path, worker->loot_capacity);
+        atomic_init(&worker->request, -1);
+        atomic_init(&worker->response, STEAL_WAITING);
+    }
+
+    // The root carries no move
+    worker = &search.workers[0];
+    worker->open[worker->open_size].next_move = 0;
+    worker->open[worker->open_size++].depth = 0;
+    worker->nodes++;
+
+    // The calling thread is worker 0
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_create(&search.workers[i].thread, NULL, stealingWorkerMain, &search.workers[i]);
+    }
+    stealingWorkerRun(&search.workers[0]);
+    for (i = 1; i < threads; ++i)
+    {
+        pthread_join(search.workers[i].thread, NULL);
+    }
+
+    bool found = search.found;
+    if (search.stuck)
+    {
+        printf("Error! No moves found for given board state!\n");
+    }
+    else if (atomic_load(&search.stop) && !found)
+    {
+        state.printer->error(state.printer, "Error: Closed set full after %lu states, raise -closed.\n",
+                            sk_atomic_key_set_count(&search.closed));
+    }
+    if (found)
+    {
+        // Populate the solution list with the winning moves
+        worker = &search.workers[search.winner];
+        for (i = 0; i < worker->path.size; ++i)
+        {
+            move *cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(worker->path.moves[i]);
+            sk_list_append(soln, cloned);
+        }
+    }
+
+    UINT_64 steals = 0;
+    for (i = 0; i < threads; ++i)
+    {
+        worker = &search.workers[i];
+        state.printer->debug(state.printer, DEBUG_DETAILS, "Worker %lu Nodes: %lu\n", i, worker->nodes);
+        *nodes_visited += worker->nodes;
+        steals += worker->steals;
+
+        destroy_search_path(&worker->path);
+        free(worker->open);
+        free(worker->key);
+        free(worker->moves);
+        free(worker->loot_path);
+    }
+    state.printer->debug(state.printer, DEBUG_DETAILS, "Steals: %lu, Closed Set: %lu states\n",
+                         steals, sk_atomic_key_set_count(&search.closed));
+
+    sk_atomic_key_set_destroy(&search.closed);
+    free(search.workers);
+
+    return found;
+}
+
+UINT_64 setBenchKey(UINT_64 k, UINT_64 key_size, UINT_8 *key)
+{
+    // SplitMix64 finalizer
+    UINT_64 z = k + 0x9E3779B97F4A7C15UL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+    z ^= z >> 31;
+
+    // The key number itself keeps keys distinct, the mixed bits fill the rest
+    UINT_64 i;
+    memcpy(key, &k, sizeof(k));
+    for (i = sizeof(k); i < key_size; ++i)
+    {
+        key[i] = (UINT_8)(z >> (8 * (i % sizeof(z))));
+    }
+    return z;
+}
+
+void *setBenchWorkerMain(void *p)
+{
+    set_bench_worker *worker = p;
+    UINT_8 *key = ALLOC(*key, worker->key_size);
+    UINT_64 offset = worker->id * (worker->keys / worker->threads);
+    UINT_64 fingerprint;
+    UINT_64 j;
+    int result;
+
+    pthread_barrier_wait(worker->start);
+    for (j = 0; j < worker->keys; ++j)
+    {
+        fingerprint = setBenchKey((j * SET_BENCH_STRIDE + offset) & (worker->keys - 1), worker->key_size, key);
+        result = sk_atomic_key_set_insert(worker->set, fingerprint, key);
+        worker->inserted += SK_KEY_SET_INSERTED == result;
+        worker->full += SK_KEY_SET_FULL == result;
+    }
+
+    free(key);
+    return NULL;
+}
+
+bool atomicSetBenchmark(UINT_64 max_threads)
+{
+    UINT_64 key_size = CLOSED_KEY_SIZE(&state.level);
+    if (key_size < sizeof(UINT_64))
+    {
+        key_size = sizeof(UINT_64);
+    }
+
+    UINT_8 *key = ALLOC(*key, key_size);
+    set_bench_worker *workers = ALLOC(*workers, max_threads);
+    sk_atomic_key_set set;
+    pthread_barrier_t start_barrier;
+    struct timeval start, stop;
+    float elapsed;
+    float base_time = 0;
+    bool passed = true;
+    UINT_64 threads = 1;
+    UINT_64 inserted;
+    UINT_64 full;
+    UINT_64 missing;
+    UINT_64 i;
+
+    printf("Atomic key set: %lu keys of %lu bytes\n", SET_BENCH_KEYS, key_size);
+    while (true)
+    {
+        if (!sk_atomic_key_set_init(&set, key_size, SET_BENCH_KEYS))
+        {
+            state.printer->error(state.printer, "Error: Failed to allocate the benchmark set.\n");
+            passed = false;
+            break;
+        }
+        pthread_barrier_init(&start_barrier, NULL, threads + 1);
+
+        for (i = 0; i < threads; ++i)
+        {
+            memset(&workers[i], 0, sizeof(workers[i]));
+            workers[i].set = &set;
+            workers[i].id = i;
+            workers[i].threads = threads;
+            workers[i].keys = SET_BENCH_KEYS;
+            workers[i].key_size = key_size;
+            workers[i].start = &start_barrier;
+            pthread_create(&workers[i].thread, NULL, setBenchWorkerMain, &workers[i]);
+        }
+
+        pthread_barrier_wait(&start_barrier);
+        gettimeofday(&start, NULL);
+        for (i = 0; i < threads; ++i)
+        {
+            pthread_join(workers[i].thread, NULL);
+        }
+        gettimeofday(&stop, NULL);
+        elapsed = stop.tv_sec - start.tv_sec + (stop.tv_usec - start.tv_usec)/(float)1000000;
+        if (1 == threads)
+        {
+            base_time = elapsed;
+        }
+
+        // Every key must have been reported new by exactly one thread and be found now
+        inserted = 0;
+        full = 0;
+        for (i = 0; i < threads; ++i)
+        {
+            inserted += workers[i].inserted;
+            full += workers[i].full;
+        }
+        missing = 0;
+        for (i = 0; i < SET_BENCH_KEYS; ++i)
+        {
+            missing += !sk_atomic_key_set_contains(&set, setBenchKey(i, key_size, key), key);
+        }
+        bool ok = inserted == SET_BENCH_KEYS && !full && !missing
+               && sk_atomic_key_set_count(&set) == SET_BENCH_KEYS;
+        passed = passed && ok;
+
+        printf("Threads: %lu, Inserts: %lu, Time: %0.4f s, Mops/sec: %0.2f, Scaling: %0.2f, Check: %s\n",
+                threads, threads * SET_BENCH_KEYS, elapsed,
+                elapsed > 0 ? threads * SET_BENCH_KEYS / elapsed / 1000000 : 0,
+                elapsed > 0 ? base_time * threads / elapsed : 0,
+                ok ? "passed" : "FAILED");
+        if (!ok)
+        {
+            printf("    %lu reported new, %lu full, %lu missing\n", inserted, full, missing);
+        }
+
+        pthread_barrier_destroy(&start_barrier);
+        sk_atomic_key_set_destroy(&set);
+
+        if (threads == max_threads)
+        {
+            break;
+        }
+        threads = threads * 2 < max_threads ? threads * 2 : max_threads;
+    }
+
+    free(workers);
+    free(key);
+    return passed;
+}
+
+double monotonicSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+void boardView(board_state *shape, tile_t *tiles, UINT_64 hash, board_state *dest)
+{
+    *dest = *shape;
+    dest->tiles = tiles;
+    dest->piece_first = (UINT_16 *)(dest->tiles + CELLS(dest));
+    dest->piece_cells = dest->piece_first + dest->max_piece + 2;
+    dest->hash = hash;
+}
+
+void batchBoard(pipeline_search *search, pipeline_batch *batch, UINT_64 i, board_state *dest)
+{
+    boardView(&search->frontier.shape, &batch->boards[i * search->frontier.slot_tiles],
+              batch->hashes[i], dest);
+}
+
+void pipelineEncode(pipeline_search *search, pipeline_batch *batch)
+{
+    UINT_8 key[search->key_size + KEY_HASH_BYTES];
+    board_state board;
+    UINT_64 i;
+
+    for (i = 0; i < batch->count; ++i)
+    {
+        batchBoard(search, batch, i, &board);
+        encodeStateKey(&board, key);
+        memcpy(&batch->keys[i * search->key_size], key + KEY_HASH_BYTES, search->key_size);
+    }
+}
+
+void pipelineDetect(pipeline_search *search, pipeline_batch *batch)
+{
+    UINT_64 i;
+    for (i = 0; i < batch->count; ++i)
+    {
+        batch->fresh[i] = sk_key_table_insert(&search->closed, batch->hashes[i],
+                                              &batch->keys[i * search->key_size]);
+    }
+}
+
+void *pipelineStageMain(void *p)
+{
+    pipeline_stage *stage = p;
+    pipeline_search *search = stage->search;
+    pipeline_batch *batch;
+    double start;
+
+    while (!atomic_load(&search->done))
+    {
+        batch = sk_spsc_queue_pop(stage->input);
+        if (!batch)
+        {
+            sched_yield();
+            continue;
+        }
+
+        start = monotonicSeconds();
+        stage->process(search, batch);
+        stage->busy += monotonicSeconds() - start;
+        stage->batches++;
+
+        // Every batch in circulation fits in every queue
+        sk_spsc_queue_push(stage->output, batch);
+    }
+
+    return NULL;
+}
+
+bool pipelinedBreadthFirst(board_state *source, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln)
+    {
+        return false;
+    }
+
+    // The stages only test successors, so a solved start never reaches them
+    if (gameStateSolved(source))
+    {
+        (*nodes_visited)++;
+        return true;
+    }
+
+    pipeline_search search;
+    initBreadthFrontier(&search.frontier, source);
+    sk_key_table_init(&search.closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT);
+    search.key_size = CLOSED_KEY_SIZE(&state.level);
+    atomic_init(&search.done, false);
+
+    // A batch takes every successor of a node, so it holds at least a node's worth
+    search.batch_capacity = PIPELINE_BATCH;
+    if (search.batch_capacity < (UINT_64)MOVE_CAPACITY(source))
+    {
+        search.batch_capacity = MOVE_CAPACITY(source);
+    }
+
+    UINT_64 i;
+    pipeline_batch *batch;
+    search.num_batches = PIPELINE_BATCHES;
+    search.batches = ALLOC(*search.batches, search.num_batches);
+    for (i = 0; i < search.num_batches; ++i)
+    {
+        batch = &search.batches[i];
+        batch->count = 0;
+        batch->parents = ALLOC(*batch->parents, search.batch_capacity);
+        batch->moves = ALLOC(*batch->moves, search.batch_capacity);
+        batch->hashes = ALLOC(*batch->hashes, search.batch_capacity);
+        batch->boards = ALLOC(*batch->boards, search.batch_capacity * search.frontier.slot_tiles);
+        batch->keys = ALLOC(*batch->keys, search.batch_capacity * search.key_size);
+        batch->fresh = ALLOC(*batch->fresh, search.batch_capacity);
+    }
+    for (i = 0; i < 3; ++i)
+    {
+        sk_spsc_queue_init(&search.queues[i], search.num_batches);
+        memset(&search.stages[i], 0, sizeof(search.stages[i]));
+        search.stages[i].search = &search;
+    }
+
+    pipeline_stage *generate = &search.stages[0];
+    generate->name = "Generate";
+    generate->input = &search.queues[2];
+    generate->output = &search.queues[0];
+
+    search.stages[1].name = "Encode";
+    search.stages[1].process = pipelineEncode;
+    search.stages[1].input = &search.queues[0];
+    search.stages[1].output = &search.queues[1];
+
+    search.stages[2].name = "Detect";
+    search.stages[2].process = pipelineDetect;
+    search.stages[2].input = &search.queues[1];
+    search.stages[2].output = &search.queues[2];
+
+    double started = monotonicSeconds();
+    for (i = 1; i < 3; ++i)
+    {
+        pthread_create(&search.stages[i].thread, NULL, pipelineStageMain, &search.stages[i]);
+    }
+
+    // The calling thread is the generating stage. Batches it is not filling or waiting
+    //      on are stacked up for reuse.
+    breadth_frontier *frontier = &search.frontier;
+    pipeline_batch **idle = ALLOC(*idle, search.num_batches);
+    UINT_64 num_idle = search.num_batches;
+    UINT_64 in_flight = 0;
+    for (i = 0; i < search.num_batches; ++i)
+    {
+        idle[i] = &search.batches[i];
+    }
+
+    packed_move *moves = ALLOC(*moves, MOVE_CAPACITY(source));
+    UINT_64 num_moves;
+    UINT_64 m;
+    UINT_64 current;
+    board_state parent;
+    board_state next;
+    bool found = false;
+    UINT_64 solved_parent = 0;
+    packed_move solved_move = 0;
+    double start;
+
+    while (true)
+    {
+        // Add the new successors of returned batches to the frontier, in order
+        while ((batch = sk_spsc_queue_pop(generate->input)))
+        {
+            start = monotonicSeconds();
+            for (i = 0; i < batch->count; ++i)
+            {
+                if (batch->fresh[i])
+                {
+                    frontierReserve(frontier, &next);
+                    memcpy(next.tiles, &batch->boards[i * frontier->slot_tiles],
+                           frontier->slot_tiles * sizeof(*next.tiles));
+                    next.hash = batch->hashes[i];
+                    frontierCommit(frontier, &next, batch->parents[i], batch->moves[i]);
+                }
+            }
+            generate->busy += monotonicSeconds() - start;
+            idle[num_idle++] = batch;
+            in_flight--;
+        }
+
+        // Once solved, the successors generated before the solution still enter the
+        //      frontier, so the node count matches uninformedBreadthFirst
+        if (found || frontier->head == frontier->count || !num_idle)
+        {
+            if ((found || frontier->head == frontier->count) && !in_flight)
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        // Fill a batch with the successors of as many frontier nodes as fit
+        start = monotonicSeconds();
+        batch = idle[--num_idle];
+        batch->count = 0;
+        while (!found && frontier->head < frontier->count
+            && batch->count + MOVE_CAPACITY(source) <= search.batch_capacity)
+        {
+            current = frontier->head++;
+            frontierBoard(frontier, current, &parent);
+            num_moves = generateMoves(&parent, moves, MOVE_CAPACITY(source));
+            for (m = 0; m < num_moves; ++m)
+            {
+                batchBoard(&search, batch, batch->count, &next);
+                cloneGameStateInto(&parent, &next, next.tiles);
+                applyMove(&next, unpackMove(moves[m]));
+
+                if (gameStateSolved(&next))
+                {
+                    found = true;
+                    solved_parent = current;
+                    solved_move = moves[m];
+                    break;
+                }
+
+                batch->parents[batch->count] = current;
+                batch->moves[batch->count] = moves[m];
+                batch->hashes[batch->count] = next.hash;
+                batch->count++;
+            }
+        }
+        generate->busy += monotonicSeconds() - start;
+        generate->batches++;
+
+        sk_spsc_queue_push(generate->output, batch);
+        in_flight++;
+    }
+
+    atomic_store(&search.done, true);
+    for (i = 1; i < 3; ++i)
+    {
+        pthread_join(search.stages[i].thread, NULL);
+    }
+    double elapsed = monotonicSeconds() - started;
+
+    for (i = 0; i < 3; ++i)
+    {
+        printf("Stage %s: %lu batches, busy %0.1f%%\n", search.stages[i].name, search.stages[i].batches,
+                elapsed > 0 ? 100 * search.stages[i].busy / elapsed : 0);
+    }
+
+    *nodes_visited += frontier->count;
+    if (found)
+    {
+        // Populate the solution list by walking back up to the root
+        UINT_64 step = solved_parent;
+        move *cloned = ALLOC(*cloned, 1);
+        *cloned = unpackMove(solved_move);
+        sk_list_prepend(soln, cloned);
+        for (; FRONTIER_NODE(frontier, parents, step) != step; step = FRONTIER_NODE(frontier, parents, step))
+        {
+            cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(FRONTIER_NODE(frontier, moves, step));
+            sk_list_prepend(soln, cloned);
+        }
+    }
+
+    free(moves);
+    free(idle);
+    for (i = 0; i < search.num_batches; ++i)
+    {
+        batch = &search.batches[i];
+        free(batch->parents);
+        free(batch->moves);
+        free(batch->hashes);
+        free(batch->boards);
+        free(batch->keys);
+        free(batch->fresh);
+    }
+    free(search.batches);
+    for (i = 0; i < 3; ++i)
+    {
+        sk_spsc_queue_destroy(&search.queues[i]);
+    }
+    sk_key_table_destroy(&search.closed);
+    destroy_breadth_frontier(&search.frontier);
+
+    return found;
+}
+
+bool sendFully(int fd, const void *data, UINT_64 size)
+{
+    const UINT_8 *bytes = data;
+    ssize_t written;
+    while (size > 0)
+    {
+        written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool receiveFully(int fd, void *data, UINT_64 size)
+{
+    UINT_8 *bytes = data;
+    ssize_t got;
+    while (size > 0)
+    {
+        got = recv(fd, bytes, size, 0);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        bytes += got;
+        size -= got;
+    }
+    return true;
+}
+
+void mpBufferReserve(mp_buffer *buffer, UINT_64 size)
+{
+    if (size <= buffer->capacity)
+    {
+        return;
+    }
+
+    while (buffer->capacity < size)
+    {
+        buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+    }
+    buffer->data = REALLOC(buffer->data, *buffer->data, buffer->capacity);
+}
+
+bool mpExchange(mp_worker *worker)
+{
+    UINT_64 n = worker->num_workers;
+    struct pollfd *fds = ALLOC(*fds, n);
+    UINT_64 pending = 0;
+    UINT_64 peer;
+    UINT_64 expected;
+    ssize_t moved;
+    bool ok = true;
+
+    for (peer = 0; peer < n; ++peer)
+    {
+        worker->out[peer].sent = 0;
+        worker->in[peer].size = 0;
+        if (peer != worker->id)
+        {
+            pending += 2;
+        }
+    }
+
+    while (ok && pending > 0)
+    {
+        for (peer = 0; peer < n; ++peer)
+        {
+            fds[peer].fd = worker->peers[peer];
+            fds[peer].events = 0;
+            fds[peer].revents = 0;
+            if (peer == worker->id)
+            {
+                continue;
+            }
+            if (worker->out[peer].sent < worker->out[peer].size)
+            {
+                fds[peer].events |= POLLOUT;
+            }
+            if (worker->in[peer].size < 8 || worker->in[peer].size < *(UINT_64 *)worker->in[peer].data)
+            {
+                fds[peer].events |= POLLIN;
+            }
+        }
+
+        if (poll(fds, n, -1) < 0)
+        {
+            ok = errno == EINTR;
+            continue;
+        }
+
+        for (peer = 0; ok && peer < n; ++peer)
+        {
+            mp_buffer *out = &worker->out[peer];
+            mp_buffer *in = &worker->in[peer];
+
+            if (fds[peer].revents & POLLOUT)
+            {
+                moved = send(fds[peer].fd, out->data + out->sent, out->size - out->sent, MSG_NOSIGNAL);
+                if (moved > 0)
+                {
+                    out->sent += moved;
+                    pending -= out->sent == out->size;
+                }
+                else if (moved < 0 && errno != EAGAIN && errno != EINTR)
+                {
+                    ok = false;
+                }
+            }
+
+            if (fds[peer].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                // Read the length first, then the rest of the message
+                expected = in->size < 8 ? 8 : *(UINT_64 *)in->data;
+                mpBufferReserve(in, expected);
+                moved = recv(fds[peer].fd, in->data + in->size, expected - in->size, 0);
+                if (moved > 0)
+                {
+                    in->size += moved;
+                    if (in->size >= 8)
+                    {
+                        expected = *(UINT_64 *)in->data;
+                        mpBufferReserve(in, expected);
+                        pending -= in->size == expected;
+                    }
+                }
+                else if (moved == 0 || (errno != EAGAIN && errno != EINTR))
+                {
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    free(fds);
+    return ok;
+}
+
+UINT_64 mpAbsorb(mp_worker *worker, mp_buffer *buffer)
+{
+    UINT_64 fresh = 0;
+    UINT_64 offset;
+    UINT_64 parent;
+    packed_move step;
+    UINT_64 hash;
+
+    for (offset = 8; offset + worker->record_size <= buffer->size; offset += worker->record_size)
+    {
+        memcpy(&parent, buffer->data + offset, sizeof(parent));
+        memcpy(&step, buffer->data + offset + 8, sizeof(step));
+        memcpy(&hash, buffer->data + offset + 8 + sizeof(step), sizeof(hash));
+        memcpy(worker->child.tiles, buffer->data + offset + 16 + sizeof(step),
+               worker->slot_tiles * sizeof(*worker->child.tiles));
+        worker->child.hash = hash;
+
+        encodeStateKey(&worker->child, worker->key);
+        if (!sk_key_table_insert(&worker->closed, hash, worker->key + KEY_HASH_BYTES))
+        {
+            continue;
+        }
+
+        if (worker->count == worker->capacity)
+        {
+            worker->capacity *= 2;
+            worker->parents = REALLOC(worker->parents, *worker->parents, worker->capacity);
+            worker->steps = REALLOC(worker->steps, *worker->steps, worker->capacity);
+        }
+        worker->parents[worker->count] = parent;
+        worker->steps[worker->count] = step;
+        worker->count++;
+
+        if (worker->next_count == worker->next_capacity)
+        {
+            worker->next_capacity *= 2;
+            worker->next = REALLOC(worker->next, *worker->next, worker->next_capacity * worker->slot_tiles);
+            worker->next_hash = REALLOC(worker->next_hash, *worker->next_hash, worker->next_capacity);
+        }
+        memcpy(&worker->next[worker->next_count * worker->slot_tiles], worker->child.tiles,
+               worker->slot_tiles * sizeof(*worker->next));
+        worker->next_hash[worker->next_count] = hash;
+        worker->next_count++;
+        fresh++;
+    }
+
+    return fresh;
+}
+
+bool mpExpandLayer(mp_worker *worker, mp_report *report)
+{
+    UINT_64 capacity = MOVE_CAPACITY(&worker->shape);
+    UINT_64 peer;
+    UINT_64 n;
+    UINT_64 m;
+    UINT_64 num_moves;
+    UINT_64 index;
+    UINT_64 ref;
+    mp_buffer *out;
+
+    memset(report, 0, sizeof(*report));
+    for (peer = 0; peer < worker->num_workers; ++peer)
+    {
+        mpBufferReserve(&worker->out[peer], 8);
+        worker->out[peer].size = 8;
+    }
+
+    for (n = 0; n < worker->layer_count && !report->found; ++n)
+    {
+        index = worker->layer_start + n;
+        boardView(&worker->shape, &worker->layer[n * worker->slot_tiles], worker->layer_hash[n],
+                  &worker->parent);
+        num_moves = generateMoves(&worker->parent, worker->moves, capacity);
+        for (m = 0; m < num_moves; ++m)
+        {
+            cloneGameStateInto(&worker->parent, &worker->child, worker->child.tiles);
+            applyMove(&worker->child, unpackMove(worker->moves[m]));
+
+            if (gameStateSolved(&worker->child))
+            {
+                report->found = 1;
+                report->parent = MP_REF(worker->id, index);
+                report->step = worker->moves[m];
+                break;
+            }
+
+            out = &worker->out[CLOSED_SHARD(worker->child.hash, worker->num_workers)];
+            mpBufferReserve(out, out->size + worker->record_size);
+            ref = MP_REF(worker->id, index);
+            memcpy(out->data + out->size, &ref, sizeof(ref));
+            memcpy(out->data + out->size + 8, &worker->moves[m], sizeof(worker->moves[m]));
+            memcpy(out->data + out->size + 8 + sizeof(packed_move), &worker->child.hash,
+                   sizeof(worker->child.hash));
+            memcpy(out->data + out->size + 16 + sizeof(packed_move), worker->child.tiles,
+                   worker->slot_tiles * sizeof(*worker->child.tiles));
+            out->size += worker->record_size;
+        }
+    }
+
+    for (peer = 0; peer < worker->num_workers; ++peer)
+    {
+        memcpy(worker->out[peer].data, &worker->out[peer].size, 8);
+    }
+    if (!mpExchange(worker))
+    {
+        return false;
+    }
+
+    // Absorb in worker order, so the layer is the same however the messages arrived
+    worker->layer_start += worker->layer_count;
+    worker->next_count = 0;
+    for (peer = 0; peer < worker->num_workers; ++peer)
+    {
+        report->fresh += mpAbsorb(worker, peer == worker->id ? &worker->out[peer] : &worker->in[peer]);
+    }
+
+    tile_t *tiles = worker->layer;
+    UINT_64 *hashes = worker->layer_hash;
+    UINT_64 swap_capacity = worker->layer_capacity;
+    worker->layer = worker->next;
+    worker->layer_hash = worker->next_hash;
+    worker->layer_capacity = worker->next_capacity;
+    worker->layer_count = worker->next_count;
+    worker->next = tiles;
+    worker->next_hash = hashes;
+    worker->next_capacity = swap_capacity;
+
+    return true;
+}
+
+bool mpWorkerRun(mp_worker *worker, board_state *source)
+{
+    UINT_64 peer;
+    UINT_64 n = worker->num_workers;
+
+    worker->shape = *source;
+    worker->slot_tiles = BOARD_BUFFER_SIZE(source);
+    worker->record_size = 16 + sizeof(packed_move) + worker->slot_tiles * sizeof(tile_t);
+    cloneGameState(source, &worker->child);
+    sk_key_table_init(&worker->closed, CLOSED_KEY_SIZE(&state.level), CLOSED_SIZE_HINT / n + 1);
+    worker->key = ALLOC(*worker->key, state.level.key_size);
+    worker->moves = ALLOC(*worker->moves, MOVE_CAPACITY(source));
+
+    worker->count = 0;
+    worker->capacity = 1024;
+    worker->parents = ALLOC(*worker->parents, worker->capacity);
+    worker->steps = ALLOC(*worker->steps, worker->capacity);
+    worker->layer_start = 0;
+    worker->layer_count = 0;
+    worker->layer_capacity = 1024;
+    worker->layer = ALLOC(*worker->layer, worker->layer_capacity * worker->slot_tiles);
+    worker->layer_hash = ALLOC(*worker->layer_hash, worker->layer_capacity);
+    worker->next_count = 0;
+    worker->next_capacity = 1024;
+    worker->next = ALLOC(*worker->next, worker->next_capacity * worker->slot_tiles);
+    worker->next_hash = ALLOC(*worker->next_hash, worker->next_capacity);
+    worker->out = ALLOC(*worker->out, n);
+    worker->in = ALLOC(*worker->in, n);
+    memset(worker->out, 0, n * sizeof(*worker->out));
+    memset(worker->in, 0, n * sizeof(*worker->in));
+
+    // The owner of the root starts with it as its only layer
+    if (CLOSED_SHARD(source->hash, n) == worker->id)
+    {
+        encodeStateKey(source, worker->key);
+        sk_key_table_insert(&worker->closed, source->hash, worker->key + KEY_HASH_BYTES);
+        worker->parents[0] = MP_ROOT;
+        worker->steps[0] = 0;
+        worker->count = 1;
+        memcpy(worker->layer, source->tiles, worker->slot_tiles * sizeof(*worker->layer));
+        worker->layer_hash[0] = source->hash;
+        worker->layer_count = 1;
+    }
+
+    mp_command command;
+    mp_report report;
+    bool stopped = false;
+    while (!stopped && receiveFully(worker->control, &command, sizeof(command)))
+    {
+        switch (command.type)
+        {
+        case MP_EXPAND:
+            if (!mpExpandLayer(worker, &report))
+            {
+                printf("Error! Worker %lu lost contact with its peers.\n", worker->id);
+                stopped = true;
+                break;
+            }
+            sendFully(worker->control, &report, sizeof(report));
+            break;
+        case MP_LOOKUP:
+            memset(&report, 0, sizeof(report));
+            if (command.value < worker->count)
+            {
+                report.parent = worker->parents[command.value];
+                report.step = worker->steps[command.value];
+            }
+            sendFully(worker->control, &report, sizeof(report));
+            break;
+        default:
+            stopped = true;
+            break;
+        }
+    }
+
+    for (peer = 0; peer < n; ++peer)
+    {
+        free(worker->out[peer].data);
+        free(worker->in[peer].data);
+    }
+    free(worker->out);
+    free(worker->in);
+    free(worker->next);
+    free(worker->next_hash);
+    free(worker->layer);
+    free(worker->layer_hash);
+    free(worker->parents);
+    free(worker->steps);
+    free(worker->moves);
+    free(worker->key);
+    sk_key_table_destroy(&worker->closed);
+    destroy_board_state(&worker->child);
+
+    return stopped && command.type == MP_STOP;
+}
+
+bool distributedBreadthFirst(board_state *source, UINT_64 workers, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln || !workers)
+    {
+        return false;
+    }
+
+    // Workers only test the successors they receive, so check the start before forking
+    if (gameStateSolved(source))
+    {
+        (*nodes_visited)++;
+        return true;
+    }
+
+    // One socket pair between the coordinator and each worker, and one between every
+    //      two workers. mesh[i * workers + j] is worker i's end towards worker j.
+    int *control = ALLOC(*control, 2 * workers);
+    int *mesh = ALLOC(*mesh, workers * workers);
+    pid_t *pids = ALLOC(*pids, workers);
+    UINT_64 i;
+    UINT_64 j;
+    int pair[2];
+    bool ok = true;
+
+    for (i = 0; i < workers * workers; ++i)
+    {
+        mesh[i] = -1;
+    }
+    for (i = 0; ok && i < workers; ++i)
+    {
+        ok = socketpair(AF_UNIX, SOCK_STREAM, 0, &control[2 * i]) == 0;
+        for (j = i + 1; ok && j < workers; ++j)
+        {
+            ok = socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == 0;
+            if (ok)
+            {
+                mesh[i * workers + j] = pair[0];
+                mesh[j * workers + i] = pair[1];
+                fcntl(pair[0], F_SETFL, O_NONBLOCK);
+                fcntl(pair[1], F_SETFL, O_NONBLOCK);
+            }
+        }
+    }
+    if (!ok)
+    {
+        printf("Error! Failed to create sockets for %lu workers: %s\n", workers, strerror(errno));
+        free(pids);
+        free(mesh);
+        free(control);
+        return false;
+    }
+
+    // Children inherit unwritten output, which must not be printed twice
+    fflush(NULL);
+    for (i = 0; i < workers; ++i)
+    {
+        pids[i] = fork();
+        if (pids[i] == 0)
+        {
+            mp_worker worker;
+            memset(&worker, 0, sizeof(worker));
+            worker.id = i;
+            worker.num_workers = workers;
+            worker.control = control[2 * i + 1];
+            worker.peers = &mesh[i * workers];
+            for (j = 0; j < workers; ++j)
+            {
+                close(control[2 * j]);
+                if (j != i)
+                {
+                    close(control[2 * j + 1]);
+                }
+            }
+            for (j = 0; j < workers * workers; ++j)
+            {
+                if (mesh[j] >= 0 && j / workers != i)
+                {
+                    close(mesh[j]);
+                }
+            }
+
+            ok = mpWorkerRun(&worker, source);
+            fflush(NULL);
+            _exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        if (pids[i] < 0)
+        {
+            printf("Error! Failed to start worker %lu: %s\n", i, strerror(errno));
+            ok = false;
+            break;
+        }
     }
 
-    // Step 0: Ensure that program configuration is valid.
-    if (!validate_global_state(&state))
+    UINT_64 started = i;
+    for (i = 0; i < workers; ++i)
     {
-        state.printer->error(state.printer, "Program configuaration invalid. Aborting.\n");
-        retval = EXIT_FAILURE;
-        goto cleanup;
+        close(control[2 * i + 1]);
+    }
+    for (i = 0; i < workers * workers; ++i)
+    {
+        if (mesh[i] >= 0)
+        {
+            close(mesh[i]);
+        }
     }
 
-    // Retrieve and normalize the starting state
-    loadGameState(state.resolved_path->string);
-    normalizeState(state.game_state);
+    // Drive the workers a layer at a time until one generates a solved board
+    UINT_64 *owned = ALLOC(*owned, workers);
+    memset(owned, 0, workers * sizeof(*owned));
+    owned[CLOSED_SHARD(source->hash, workers)] = 1;
+    mp_command command;
+    mp_report report;
+    mp_report solution;
+    bool found = false;
+    UINT_64 fresh = 1;
+    memset(&solution, 0, sizeof(solution));
+
+    while (ok && !found && fresh > 0)
+    {
+        command.type = MP_EXPAND;
+        command.value = 0;
+        for (i = 0; ok && i < workers; ++i)
+        {
+            ok = sendFully(control[2 * i], &command, sizeof(command));
+        }
 
-    if (state.random_walk)
+        fresh = 0;
+        for (i = 0; ok && i < workers; ++i)
+        {
+            ok = receiveFully(control[2 * i], &report, sizeof(report));
+            if (ok)
+            {
+                owned[i] += report.fresh;
+                fresh += report.fresh;
+                if (report.found && !found)
+                {
+                    found = true;
+                    solution = report;
+                }
+            }
+        }
+    }
+
+    // Walk back up to the root, asking the owner of each state for its parent
+    if (ok && found)
     {
-        // Perform N random moves upon the starting state
-        randomWalks(state.game_state, state.N);
+        move *cloned = ALLOC(*cloned, 1);
+        *cloned = unpackMove((packed_move)solution.step);
+        sk_list_prepend(soln, cloned);
+
+        UINT_64 ref = solution.parent;
+        while (ok && ref != MP_ROOT)
+        {
+            command.type = MP_LOOKUP;
+            command.value = MP_REF_INDEX(ref);
+            ok = sendFully(control[2 * MP_REF_WORKER(ref)], &command, sizeof(command))
+                && receiveFully(control[2 * MP_REF_WORKER(ref)], &report, sizeof(report));
+            if (ok && report.parent != MP_ROOT)
+            {
+                cloned = ALLOC(*cloned, 1);
+                *cloned = unpackMove((packed_move)report.step);
+                sk_list_prepend(soln, cloned);
+            }
+            ref = report.parent;
+        }
     }
-    else if (state.depth_first)
+    if (!ok)
+    {
+        printf("Error! Lost contact with a worker process.\n");
+        clearSolution(soln);
+        found = false;
+    }
+
+    command.type = MP_STOP;
+    command.value = 0;
+    for (i = 0; i < workers; ++i)
+    {
+        sendFully(control[2 * i], &command, sizeof(command));
+        close(control[2 * i]);
+    }
+    for (i = 0; i < started; ++i)
+    {
+        waitpid(pids[i], NULL, 0);
+    }
+
+    printf("Worker States:");
+    for (i = 0; i < workers; ++i)
+    {
+        printf(" %lu", owned[i]);
+        *nodes_visited += owned[i];
+    }
+    printf("\n");
+
+    free(owned);
+    free(pids);
+    free(mesh);
+    free(control);
+
+    return found;
+}
+
+int compareExternalRecords(const void *a, const void *b)
+{
+    return memcmp(*(UINT_8 * const *)a, *(UINT_8 * const *)b, state.level.key_size);
+}
+
+bool writeExternalRun(external_search *search)
+{
+    if (search->num_runs == search->run_capacity)
     {
-        object_base board_state_base =
+        search->run_capacity *= 2;
+        search->runs = REALLOC(search->runs, *search->runs, search->run_capacity);
+    }
+
+    int fd = sk_record_file_create(search->dir);
+    sk_record_stream out;
+    if (fd < 0 || !sk_record_stream_open(&out, fd, search->record_size, search->io_buffer, true))
+    {
+        if (fd >= 0)
         {
-            .hash       = hashBoardState,
-            .compare    = NULL,
-            .equals     = stateEqual,
-            .clone      = shallow_clone,
-            .concat     = NULL,
-            .destroy    = no_free,
-            .cleanup    = static_cleanup
-        };
+            close(fd);
+        }
+        return false;
+    }
+    search->runs[search->num_runs++] = fd;
+    search->total_runs++;
 
-        sk_list soln;
-        sk_list open;
-        sk_hash_table closed;
-        UINT_64 nodes = 0;
-        UINT_64 soln_size = 0;
-        sk_list_init(&soln, NULL);
-        sk_list_init(&open, NULL);
-        sk_hash_table_init(&closed, 100000, &board_state_base);
+    qsort(search->sort_order, search->sort_count, sizeof(*search->sort_order), compareExternalRecords);
 
-        struct timeval start, stop;
-        gettimeofday(&start, NULL);
-        if (!uninformedDepthFirst(state.game_state, &closed, &open, &soln, &nodes))
+    bool ok = true;
+    UINT_64 i;
+    for (i = 0; ok && i < search->sort_count; ++i)
+    {
+        if (i && !memcmp(search->sort_order[i - 1], search->sort_order[i], search->key_size))
         {
-            printf("No solution found!\n");
+            continue;
         }
-        else
+        ok = sk_record_stream_write(&out, search->sort_order[i]);
+        search->bytes_written += search->record_size;
+    }
+
+    search->sort_count = 0;
+    return sk_record_stream_close(&out) && ok;
+}
+
+bool externalLayerContains(sk_record_stream *stream, const UINT_8 **head, const UINT_8 *key, UINT_64 key_size)
+{
+    while (*head && memcmp(*head, key, key_size) < 0)
+    {
+        *head = sk_record_stream_read(stream);
+    }
+    return *head && !memcmp(*head, key, key_size);
+}
+
+bool mergeExternalLayer(external_search *search)
+{
+    if (search->num_layers == search->layer_capacity)
+    {
+        search->layer_capacity *= 2;
+        search->layers = REALLOC(search->layers, *search->layers, search->layer_capacity);
+        search->layer_count = REALLOC(search->layer_count, *search->layer_count, search->layer_capacity);
+    }
+
+    int fd = sk_record_file_create(search->dir);
+    if (fd < 0)
+    {
+        return false;
+    }
+    search->layers[search->num_layers] = fd;
+    search->layer_count[search->num_layers] = 0;
+
+    // Every run, the two previous layers and the output share the memory cap
+    UINT_64 num_streams = search->num_runs + 3;
+    UINT_64 buffer_bytes = search->memory / num_streams;
+    if (buffer_bytes > EXT_IO_BUFFER)
+    {
+        buffer_bytes = EXT_IO_BUFFER;
+    }
+
+    sk_record_stream *runs = ALLOC(*runs, search->num_runs);
+    const UINT_8 **heads = ALLOC(*heads, search->num_runs);
+    UINT_64 i;
+    for (i = 0; i < search->num_runs; ++i)
+    {
+        sk_record_stream_open(&runs[i], search->runs[i], search->record_size, buffer_bytes, false);
+        heads[i] = sk_record_stream_read(&runs[i]);
+    }
+
+    // A successor of layer d can only repeat a state of layer d or d - 1
+    sk_record_stream previous[2];
+    const UINT_8 *previous_head[2] = {NULL, NULL};
+    UINT_64 num_previous = search->num_layers < 2 ? search->num_layers : 2;
+    for (i = 0; i < num_previous; ++i)
+    {
+        sk_record_stream_open(&previous[i], search->layers[search->num_layers - 1 - i], search->record_size,
+                              buffer_bytes, false);
+        previous_head[i] = sk_record_stream_read(&previous[i]);
+    }
+
+    sk_record_stream out;
+    bool ok = sk_record_stream_open(&out, fd, search->record_size, buffer_bytes, true);
+    UINT_8 *last = ALLOC(*last, search->key_size);
+    bool have_last = false;
+    UINT_64 best;
+    const UINT_8 *record;
+
+    while (ok)
+    {
+        best = search->num_runs;
+        for (i = 0; i < search->num_runs; ++i)
         {
-            gettimeofday(&stop, NULL);
-            soln_size = sk_list_size(&soln);
+            if (heads[i] && (best == search->num_runs
+                || memcmp(heads[i], heads[best], search->key_size) < 0))
+            {
+                best = i;
+            }
+        }
+        if (best == search->num_runs)
+        {
+            break;
+        }
+
+        record = heads[best];
+        if (!have_last || memcmp(last, record, search->key_size))
+        {
+            memcpy(last, record, search->key_size);
+            have_last = true;
+
+            if (!externalLayerContains(&previous[0], &previous_head[0], record, search->key_size)
+             && !(num_previous > 1
+               && externalLayerContains(&previous[1], &previous_head[1], record, search->key_size)))
+            {
+                ok = sk_record_stream_write(&out, record);
+                search->layer_count[search->num_layers]++;
+                search->bytes_written += search->record_size;
+            }
+        }
+        heads[best] = sk_record_stream_read(&runs[best]);
+    }
+
+    ok = sk_record_stream_close(&out) && ok;
+    for (i = 0; i < num_previous; ++i)
+    {
+        sk_record_stream_close(&previous[i]);
+    }
+    for (i = 0; i < search->num_runs; ++i)
+    {
+        sk_record_stream_close(&runs[i]);
+        close(search->runs[i]);
+    }
+    search->num_runs = 0;
+    search->num_layers++;
+
+    free(last);
+    free(heads);
+    free(runs);
+
+    return ok;
+}
+
+bool externalBreadthFirst(board_state *source, UINT_64 memory, sk_list *soln, UINT_64 *nodes_visited)
+{
+    if (!source || !soln)
+    {
+        return false;
+    }
+
+    // A solved start needs no layer files; successors are tested as they are spilled
+    if (gameStateSolved(source))
+    {
+        (*nodes_visited)++;
+        return true;
+    }
+
+    external_search search;
+    memset(&search, 0, sizeof(search));
+    search.memory = memory;
+    search.dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    search.key_size = state.level.key_size;
+    search.slot_tiles = BOARD_BUFFER_SIZE(source);
+    search.record_size = search.key_size + sizeof(UINT_64) + sizeof(packed_move)
+                       + search.slot_tiles * sizeof(tile_t);
+
+    // Generating a layer holds the layer reader, the run writer and the sort buffer.
+    //      The two streams take no more than half of the cap between them.
+    UINT_64 capacity = MOVE_CAPACITY(source);
+    search.io_buffer = memory / 4 < EXT_IO_BUFFER ? memory / 4 : EXT_IO_BUFFER;
+    UINT_64 sort_bytes = memory - 2 * search.io_buffer;
+    search.sort_capacity = sort_bytes / (search.record_size + sizeof(*search.sort_order));
+    if (search.sort_capacity < capacity)
+    {
+        printf("Error! A memory cap of %lu bytes leaves no room to sort successors.\n", memory);
+        return false;
+    }
+
+    UINT_64 parent_offset = search.key_size;
+    UINT_64 step_offset = parent_offset + sizeof(UINT_64);
+    UINT_64 tiles_offset = step_offset + sizeof(packed_move);
+    UINT_64 tiles_bytes = search.slot_tiles * sizeof(tile_t);
+
+    search.layer_capacity = 64;
+    search.layers = ALLOC(*search.layers, search.layer_capacity);
+    search.layer_count = ALLOC(*search.layer_count, search.layer_capacity);
+    search.run_capacity = 16;
+    search.runs = ALLOC(*search.runs, search.run_capacity);
+
+    // Layer 0 holds the root alone
+    UINT_8 *record = ALLOC(*record, search.record_size);
+    UINT_64 index = EXT_ROOT;
+    packed_move step = 0;
+    encodeStateKey(source, record);
+    memcpy(record + parent_offset, &index, sizeof(index));
+    memcpy(record + step_offset, &step, sizeof(step));
+    memcpy(record + tiles_offset, source->tiles, tiles_bytes);
+
+    sk_record_stream stream;
+    search.layers[0] = sk_record_file_create(search.dir);
+    search.layer_count[0] = 1;
+    search.num_layers = 1;
+    bool ok = search.layers[0] >= 0
+           && sk_record_stream_open(&stream, search.layers[0], search.record_size, search.io_buffer, true);
+    ok = ok && sk_record_stream_write(&stream, record) && sk_record_stream_close(&stream);
+
+    board_state parent;
+    board_state child;
+    cloneGameState(source, &parent);
+    cloneGameState(source, &child);
+    packed_move *moves = ALLOC(*moves, capacity);
+    UINT_64 num_moves;
+    UINT_64 m;
+    UINT_64 solved_parent = 0;
+    packed_move solved_move = 0;
+    bool found = false;
+    const UINT_8 *current;
+    UINT_8 *slot;
+
+    while (ok && !found && search.layer_count[search.num_layers - 1] > 0)
+    {
+        search.sort_buffer = ALLOC(*search.sort_buffer, search.sort_capacity * search.record_size);
+        search.sort_order = ALLOC(*search.sort_order, search.sort_capacity);
 
-            //outputGameState();
+        // Stream the deepest layer, spilling its successors to sorted runs
+        ok = sk_record_stream_open(&stream, search.layers[search.num_layers - 1], search.record_size,
+                                   search.io_buffer, false);
+        for (index = 0; ok && !found && (current = sk_record_stream_read(&stream)); ++index)
+        {
+            memcpy(parent.tiles, current + tiles_offset, tiles_bytes);
+            memcpy(&parent.hash, current, sizeof(parent.hash));
 
-            move *next_move;
-            sk_iterator it;
-            sk_list_begin(&it, &soln);
-            while (it.has_next(&it))
+            num_moves = generateMoves(&parent, moves, capacity);
+            for (m = 0; ok && m < num_moves; ++m)
             {
-                next_move = it.next(&it);
-                applyMove(state.game_state, *next_move);
-                switch (next_move->dir)
+                cloneGameStateInto(&parent, &child, child.tiles);
+                applyMove(&child, unpackMove(moves[m]));
+
+                if (gameStateSolved(&child))
                 {
-                case UP:
-                    printf("(%ld, up)\n", next_move->piece);
-                    break;
-                case DOWN:
-                    printf("(%ld, down)\n", next_move->piece);
-                    break;
-                case LEFT:
-                    printf("(%ld, left)\n", next_move->piece);
-                    break;
-                case RIGHT:
-                    printf("(%ld, right)\n", next_move->piece);
+                    found = true;
+                    solved_parent = index;
+                    solved_move = moves[m];
                     break;
                 }
 
-                free(next_move);
-                sk_list_remove(&it);
+                if (search.sort_count == search.sort_capacity)
+                {
+                    ok = writeExternalRun(&search);
+                }
+
+                slot = &search.sort_buffer[search.sort_count * search.record_size];
+                encodeStateKey(&child, slot);
+                memcpy(slot + parent_offset, &index, sizeof(index));
+                memcpy(slot + step_offset, &moves[m], sizeof(moves[m]));
+                memcpy(slot + tiles_offset, child.tiles, tiles_bytes);
+                search.sort_order[search.sort_count++] = slot;
             }
-            it.destroy(&it);
+        }
+        sk_record_stream_close(&stream);
 
-            printf("\n");
-            outputGameState();
-            printf("\n");
+        if (ok && !found && search.sort_count)
+        {
+            ok = writeExternalRun(&search);
+        }
+        free(search.sort_buffer);
+        free(search.sort_order);
+        search.sort_count = 0;
 
-            printf("Nodes Visited: %lu\n", nodes);
-            printf("Search time = %0.4f s\n",
-                    (float)(stop.tv_sec - start.tv_sec + (stop.tv_usec - start.tv_usec)/(float)1000000));
-            printf("Solution Size: %lu moves\n", soln_size);
+        if (ok && !found)
+        {
+            ok = mergeExternalLayer(&search);
         }
+    }
 
-        sk_list_destroy(&open);
-        sk_hash_table_destroy(&closed);
-        sk_list_destroy(&soln);
+    if (!ok)
+    {
+        printf("Error! Failed to write search layers to %s: %s\n", search.dir, strerror(errno));
+        found = false;
     }
-    else if (state.breadth_first)
+
+    printf("External Memory: %lu layers, %lu sorted runs, %lu MB written\n",
+            search.num_layers, search.total_runs, search.bytes_written >> 20);
+
+    UINT_64 i;
+    for (i = 0; i < search.num_layers; ++i)
+    {
+        *nodes_visited += search.layer_count[i];
+    }
+
+    if (found)
+    {
+        // Populate the solution list by reading each parent back from the layer above
+        move *cloned = ALLOC(*cloned, 1);
+        *cloned = unpackMove(solved_move);
+        sk_list_prepend(soln, cloned);
+
+        index = solved_parent;
+        for (i = search.num_layers - 1; found && i > 0; --i)
+        {
+            found = sk_record_file_read(search.layers[i], search.record_size, index, record);
+            memcpy(&index, record + parent_offset, sizeof(index));
+            memcpy(&step, record + step_offset, sizeof(step));
+
+            cloned = ALLOC(*cloned, 1);
+            *cloned = unpackMove(step);
+            sk_list_prepend(soln, cloned);
+        }
+        if (!found)
+        {
+            printf("Error! Failed to read back the solution path.\n");
+            clearSolution(soln);
+        }
+    }
+
+    for (i = 0; i < search.num_runs; ++i)
     {
-        object_base board_state_base =
+        close(search.runs[i]);
+    }
+    for (i = 0; i < search.num_layers; ++i)
+    {
+        if (search.layers[i] >= 0)
         {
-            .hash       = hashBoardState,
-            .compare    = NULL,
-            .equals     = stateEqual,
-            .clone      = shallow_clone,
-            .concat     = NULL,
-            .destroy    = no_free,
-            .cleanup    = static_cleanup
-        };
+            close(search.layers[i]);
+        }
+    }
+    free(moves);
+    free(record);
+    destroy_board_state(&parent);
+    destroy_board_state(&child);
+    free(search.runs);
+    free(search.layers);
+    free(search.layer_count);
+
+    return found;
+}
 
-        sk_list soln;
-        sk_hash_table closed;
-        sk_list open;
-        UINT_64 nodes = 0;
-        UINT_64 soln_size = 0;
-        sk_list_init(&soln, NULL);
-        sk_hash_table_init(&closed, 100000, &board_state_base);
-        sk_list_init(&open, NULL);
+bool checkpointDue(checkpoint_writer *writer)
+{
+    if (!writer->path || ++writer->polls < CHECKPOINT_POLL)
+    {
+        return false;
+    }
+    writer->polls = 0;
 
-        struct timeval start, stop;
-        gettimeofday(&start, NULL);
-        if (!uninformedBreadthFirst(state.game_state, &closed, &open, &soln, &nodes))
+    // The first interval starts with the search
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if (!writer->last.tv_sec)
+    {
+        writer->last = now;
+    }
+    if ((UINT_64)(now.tv_sec - writer->last.tv_sec) < writer->interval)
+    {
+        return false;
+    }
+
+    // Let a snapshot still being written finish before starting another
+    int status;
+    if (writer->writer)
+    {
+        if (waitpid(writer->writer, &status, WNOHANG) == 0)
         {
-            printf("No solution found!\n");
+            return false;
+        }
+        if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS)
+        {
+            writer->written++;
         }
         else
         {
-            gettimeofday(&stop, NULL);
-            soln_size = sk_list_size(&soln);
+            writer->failed++;
+        }
+        writer->writer = 0;
+    }
+    return true;
+}
 
-            //outputGameState();
+FILE *beginCheckpoint(checkpoint_writer *writer, UINT_64 mode, board_state *source, sk_key_table *closed,
+                      UINT_64 nodes_visited)
+{
+    struct timeval start, stop;
+    gettimeofday(&start, NULL);
 
-            move *next_move;
-            sk_iterator it;
-            sk_list_begin(&it, &soln);
-            while (it.has_next(&it))
-            {
-                next_move = it.next(&it);
-                applyMove(state.game_state, *next_move);
-                switch (next_move->dir)
-                {
-                case UP:
-                    printf("(%ld, up)\n", next_move->piece);
-                    break;
-                case DOWN:
-                    printf("(%ld, down)\n", next_move->piece);
-                    break;
-                case LEFT:
-                    printf("(%ld, left)\n", next_move->piece);
-                    break;
-                case RIGHT:
-                    printf("(%ld, right)\n", next_move->piece);
-                    break;
-                }
+    // The writer inherits unwritten output, which must not be printed twice
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid)
+    {
+        gettimeofday(&stop, NULL);
+        double pause = (stop.tv_sec - start.tv_sec) + (stop.tv_usec - start.tv_usec) / 1e6;
+        if (pause > writer->longest_pause)
+        {
+            writer->longest_pause = pause;
+        }
+        if (pid < 0)
+        {
+            printf("Error! Failed to start a snapshot: %s\n", strerror(errno));
+            writer->failed++;
+        }
+        else
+        {
+            writer->writer = pid;
+        }
+        writer->last = stop;
+        return NULL;
+    }
+
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s.tmp", writer->path);
+    FILE *out = fopen(path, "wb");
+    if (!out)
+    {
+        _exit(EXIT_FAILURE);
+    }
+
+    checkpoint_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.mode = mode;
+    header.zobrist_sum = zobristChecksum(source);
+    header.source_hash = source->hash;
+    header.key_size = state.level.key_size;
+    header.slot_tiles = BOARD_BUFFER_SIZE(source);
+    header.nodes_visited = nodes_visited;
+    if (fwrite(&header, sizeof(header), 1, out) != 1 || !sk_key_table_write(closed, out))
+    {
+        fclose(out);
+        _exit(EXIT_FAILURE);
+    }
+    return out;
+}
+
+void endCheckpoint(checkpoint_writer *writer, FILE *out)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s.tmp", writer->path);
+
+    // Only a snapshot known to be on disk may replace the previous one
+    bool ok = fwrite(CHECKPOINT_END, strlen(CHECKPOINT_END), 1, out) == 1
+           && fflush(out) == 0 && !ferror(out) && fsync(fileno(out)) == 0;
+    ok = fclose(out) == 0 && ok;
+    ok = ok && rename(path, writer->path) == 0;
+    _exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+FILE *openCheckpoint(checkpoint_writer *writer, UINT_64 mode, board_state *source, sk_key_table *closed,
+                     UINT_64 *nodes_visited)
+{
+    FILE *in = fopen(writer->resume, "rb");
+    if (!in)
+    {
+        state.printer->error(state.printer, "Error: Failed to open snapshot %s: %s.\n", writer->resume,
+                             strerror(errno));
+        return NULL;
+    }
+
+    checkpoint_header header;
+    char end[sizeof(CHECKPOINT_END) - 1];
+    if (fread(&header, sizeof(header), 1, in) != 1
+     || memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)))
+    {
+        state.printer->error(state.printer, "Error: %s is not a search snapshot.\n", writer->resume);
+    }
+    else if (header.mode != mode)
+    {
+        state.printer->error(state.printer, "Error: %s was taken by a %s first search.\n", writer->resume,
+                             header.mode == CHECKPOINT_DEPTH ? "depth" : "breadth");
+    }
+    else if (header.zobrist_sum != zobristChecksum(source))
+    {
+        state.printer->error(state.printer, "Error: %s was taken with different Zobrist keys.\n",
+                             writer->resume);
+    }
+    else if (header.source_hash != source->hash || header.key_size != state.level.key_size
+          || header.slot_tiles != BOARD_BUFFER_SIZE(source))
+    {
+        state.printer->error(state.printer, "Error: %s was taken on a different board.\n", writer->resume);
+    }
+    else if (fseek(in, -(long)sizeof(end), SEEK_END) || fread(end, sizeof(end), 1, in) != 1
+          || memcmp(end, CHECKPOINT_END, sizeof(end)) || fseek(in, sizeof(header), SEEK_SET))
+    {
+        state.printer->error(state.printer, "Error: %s is incomplete.\n", writer->resume);
+    }
+    else if (!sk_key_table_read(closed, in))
+    {
+        state.printer->error(state.printer, "Error: Failed to read the closed set from %s.\n", writer->resume);
+    }
+    else
+    {
+        *nodes_visited = header.nodes_visited;
+        return in;
+    }
+
+    fclose(in);
+    return NULL;
+}
+
+void finishCheckpoints(checkpoint_writer *writer)
+{
+    int status;
+    if (writer->writer)
+    {
+        if (waitpid(writer->writer, &status, 0) == writer->writer
+         && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS)
+        {
+            writer->written++;
+        }
+        else
+        {
+            writer->failed++;
+        }
+        writer->writer = 0;
+    }
 
-                free(next_move);
-                sk_list_remove(&it);
-            }
-            it.destroy(&it);
+    if (writer->path)
+    {
+        printf("Snapshots: %lu written to %s, %lu failed, longest pause %0.3f ms\n",
+                writer->written, writer->path, writer->failed, writer->longest_pause * 1000);
+    }
+}
 
-            printf("\n");
-            outputGameState();
-            printf("\n");
+bool saveBreadthFrontier(breadth_frontier *frontier, FILE *out)
+{
+    board_state board;
+    UINT_64 i;
+    bool ok = fwrite(&frontier->count, sizeof(frontier->count), 1, out) == 1
+           && fwrite(&frontier->head, sizeof(frontier->head), 1, out) == 1;
 
-            printf("Nodes Visited: %lu\n", nodes);
-            printf("Search time = %0.4f s\n",
-                    (float)(stop.tv_sec - start.tv_sec + (stop.tv_usec - start.tv_usec)/(float)1000000));
-            printf("Solution Size: %lu moves\n", soln_size);
+    // The root is rebuilt from the source board, so it only needs its board if unexpanded
+    for (i = 0; ok && i < frontier->count; ++i)
+    {
+        ok = fwrite(&FRONTIER_NODE(frontier, parents, i), sizeof(**frontier->parents), 1, out) == 1
+          && fwrite(&FRONTIER_NODE(frontier, moves, i), sizeof(**frontier->moves), 1, out) == 1;
+        if (ok && i >= frontier->head && i > 0)
+        {
+            frontierBoard(frontier, i, &board);
+            ok = fwrite(board.tiles, sizeof(*board.tiles), frontier->slot_tiles, out) == frontier->slot_tiles
+              && fwrite(&board.hash, sizeof(board.hash), 1, out) == 1;
         }
-
-        sk_hash_table_destroy(&closed);
-        sk_list_destroy(&open);
-        sk_list_destroy(&soln);
     }
-    else
+    return ok;
+}
+
+bool restoreBreadthFrontier(breadth_frontier *frontier, FILE *in)
+{
+    UINT_64 count;
+    UINT_64 head;
+    if (fread(&count, sizeof(count), 1, in) != 1 || fread(&head, sizeof(head), 1, in) != 1
+     || !count || head > count)
     {
-        randomWalks(state.game_state, 3);
+        return false;
     }
 
-cleanup:
-    destroy_printer(printer);
-    destroy_global_state(&state);
+    UINT_64 parent;
+    packed_move step;
+    board_state board;
+    UINT_64 i;
+    bool ok = fread(&parent, sizeof(parent), 1, in) == 1 && fread(&step, sizeof(step), 1, in) == 1;
+    for (i = 1; ok && i < count; ++i)
+    {
+        ok = fread(&parent, sizeof(parent), 1, in) == 1 && fread(&step, sizeof(step), 1, in) == 1
+          && parent < i;
+        if (!ok)
+        {
+            break;
+        }
 
-    exit(retval);
+        // Expanded nodes have no board, so they must not make the ring grow
+        frontier->head = i < head ? i : head;
+        frontierReserve(frontier, &board);
+        if (i >= head)
+        {
+            ok = fread(board.tiles, sizeof(*board.tiles), frontier->slot_tiles, in) == frontier->slot_tiles
+              && fread(&board.hash, sizeof(board.hash), 1, in) == 1;
+        }
+        frontierCommit(frontier, &board, parent, step);
+    }
+
+    frontier->head = head;
+    return ok;
 }
 
-bool loadGameState(const char *file_name)
+UINT_64 levelLayoutHash(board_state *source)
 {
-    bool retval = true;
+    UINT_64 hash = 14695981039346656037UL;
+    UINT_64 words[2] = {source->width, source->height};
+    UINT_64 i;
+    UINT_64 g;
+    UINT_8 kind;
 
-    sk_str *resolved_path = NULL;
-    if (!resolve_input_file(file_name, &resolved_path))
+    for (i = 0; i < 2; ++i)
     {
-        state.printer->error(state.printer, "Error: Failed to resolve input file path : %s.\n", file_name);
-        retval = false;
-        goto resolve_file_fail;
+        hash = (hash ^ words[i]) * 1099511628211UL;
     }
 
-    int input_fd = 0;
-    if (resolved_path && (input_fd = open(resolved_path->string, O_RDONLY)) < 0)
+    for (i = 0; i < CELLS(source); ++i)
     {
-        state.printer->error(state.printer, "Error: Failed to open input file : %s.\n", strerror(errno));
-        retval = false;
-        goto open_fail;
+        kind = WALL == source->tiles[i] ? PDB_WALL : PDB_FREE;
+        for (g = 0; g < state.level.num_goals; ++g)
+        {
+            if (state.level.goals[g] == i)
+            {
+                kind = PDB_GOAL;
+            }
+        }
+        hash = (hash ^ kind) * 1099511628211UL;
     }
 
-    UINT_64 width;
-    UINT_64 height;
+    return hash;
+}
 
-    sk_iterator token_it;
-    char *token;
-    sk_str str_token;
-    sk_str line;
+UINT_64 pieceShapeHash(board_state *source, SINT_64 piece)
+{
+    UINT_16 *cells = PIECE_CELLS(source, piece);
+    UINT_64 size = PIECE_SIZE(source, piece);
+    UINT_64 hash = (14695981039346656037UL ^ size) * 1099511628211UL;
+    SINT_64 rows;
+    SINT_64 cols;
+    UINT_64 i;
 
-    if (!fd_get_line(input_fd, &line))
+    for (i = 0; i < size; ++i)
     {
-        retval = false;
-        goto dimensions_fail;
+        rows = (SINT_64)(cells[i] / source->width) - (SINT_64)(cells[0] / source->width);
+        cols = (SINT_64)(cells[i] % source->width) - (SINT_64)(cells[0] % source->width);
+        hash = (hash ^ (UINT_64)rows) * 1099511628211UL;
+        hash = (hash ^ (UINT_64)cols) * 1099511628211UL;
     }
 
-    sk_str_split(&token_it, &line, ',');
-    int t_width;
-    int t_height;
+    return hash;
+}
 
-    token = token_it.next(&token_it);
-    sk_str_init(&str_token, token, 10);
-    parse_int(&str_token, 10, &t_width);
-    sk_str_destroy(&str_token);
+UINT_64 liveAnchor(board_state *source, UINT_64 cell)
+{
+    return (cell / source->width - state.level.row_min) * state.level.live_width
+         + cell % source->width - state.level.col_min;
+}
 
-    token = token_it.next(&token_it);
-    sk_str_init(&str_token, token, 10);
-    parse_int(&str_token, 10, &t_height);
-    sk_str_destroy(&str_token);
+UINT_64 *patternBinomials(void)
+{
+    UINT_64 live_cells = state.level.live_width * state.level.live_height;
+    UINT_64 *binomials = ALLOC(*binomials, (live_cells + 1) * (PDB_MAX_PIECES + 1));
+    UINT_64 n;
+    UINT_64 k;
 
-    state.printer->debug(state.printer, DEBUG_DETAILS,
-                            "Found width %d  height %d.\n",
-                            t_width,
-                            t_height);
+    for (n = 0; n <= live_cells; ++n)
+    {
+        PDB_BINOMIAL(binomials, n, 0) = 1;
+        for (k = 1; k <= PDB_MAX_PIECES; ++k)
+        {
+            PDB_BINOMIAL(binomials, n, k) = n ? PDB_BINOMIAL(binomials, n - 1, k - 1)
+                                              + PDB_BINOMIAL(binomials, n - 1, k) : 0;
+            if (PDB_BINOMIAL(binomials, n, k) > PDB_MAX_ENTRIES)
+            {
+                PDB_BINOMIAL(binomials, n, k) = PDB_MAX_ENTRIES + 1;
+            }
+        }
+    }
 
-    token_it.destroy(&token_it);
+    return binomials;
+}
 
-    sk_str_destroy(&line);
+UINT_64 patternIndex(const pattern_database *pattern, const UINT_64 *binomials, UINT_64 *anchors)
+{
+    UINT_64 live_cells = state.level.live_width * state.level.live_height;
+    UINT_64 index = 0;
+    UINT_64 stride = 1;
+    UINT_64 first = 0;
+    UINT_64 anchor;
+    UINT_64 rank;
+    UINT_64 g;
+    UINT_64 i;
+    UINT_64 j;
 
-    if (t_width <= 0 || t_height <= 0)
+    for (g = 0; g < pattern->num_groups; ++g)
     {
-        goto dimensions_fail;
+        // Colexicographic rank of the group's anchors as a set
+        rank = 0;
+        for (i = 0; i < pattern->groups[g]; ++i)
+        {
+            anchor = anchors[first + i];
+            for (j = first + i; j > first && anchors[j - 1] > anchor; --j)
+            {
+                anchors[j] = anchors[j - 1];
+            }
+            anchors[j] = anchor;
+        }
+        for (i = 0; i < pattern->groups[g]; ++i)
+        {
+            rank += PDB_BINOMIAL(binomials, anchors[first + i], i + 1);
+        }
+
+        index += rank * stride;
+        stride *= PDB_BINOMIAL(binomials, live_cells, pattern->groups[g]);
+        first += pattern->groups[g];
     }
-    width = t_width;
-    height = t_height;
 
-    SINT_64 **tiles = ALLOC(*tiles, height);
+    return index;
+}
+
+void patternAnchors(const pattern_database *pattern, const UINT_64 *binomials, UINT_64 index, UINT_64 *anchors)
+{
+    UINT_64 live_cells = state.level.live_width * state.level.live_height;
+    UINT_64 first = 0;
+    UINT_64 radix;
+    UINT_64 rank;
+    UINT_64 anchor;
+    UINT_64 g;
     UINT_64 i;
-    for (i = 0; i < height; ++i)
-    {
-        tiles[i] = ALLOC(*(tiles[i]), width);
-    }
 
-    UINT_64 j;
-    for (i = 0; i < height; i++)
+    for (g = 0; g < pattern->num_groups; ++g)
     {
-        if (!fd_get_line(input_fd, &line))
+        radix = PDB_BINOMIAL(binomials, live_cells, pattern->groups[g]);
+        rank = index % radix;
+        index /= radix;
+
+        // Largest anchor first, each below the one after it
+        anchor = live_cells;
+        for (i = pattern->groups[g]; i > 0; --i)
         {
-            goto matrix_fill_fail;
+            do
+            {
+                anchor--;
+            } while (PDB_BINOMIAL(binomials, anchor, i) > rank);
+            anchors[first + i - 1] = anchor;
+            rank -= PDB_BINOMIAL(binomials, anchor, i);
         }
+        first += pattern->groups[g];
+    }
+}
 
-        sk_str_split(&token_it, &line, ',');
+bool placePattern(pattern_builder *builder, const UINT_64 *anchors)
+{
+    board_state *source = builder->source;
+    level_info *level = &state.level;
+    memset(builder->occupied, 0, CELLS(source));
+
+    SINT_64 anchor_row;
+    SINT_64 anchor_col;
+    SINT_64 row;
+    SINT_64 col;
+    UINT_64 cell;
+    UINT_64 k;
+    UINT_64 i;
 
-        for (j = 0; j < width; ++j)
+    for (k = 0; k < builder->pattern->num_pieces; ++k)
+    {
+        anchor_row = level->row_min + anchors[k] / level->live_width;
+        anchor_col = level->col_min + anchors[k] % level->live_width;
+
+        for (i = 0; i < builder->sizes[k]; ++i)
         {
-            if (!token_it.has_next(&token_it))
+            row = anchor_row + builder->rows[k * level->max_size + i];
+            col = anchor_col + builder->cols[k * level->max_size + i];
+            if (row < 0 || col < 0 || row >= (SINT_64)source->height || col >= (SINT_64)source->width)
             {
-                token_it.destroy(&token_it);
-                sk_str_destroy(&line);
-                retval = false;
-                goto matrix_fill_fail;
+                return false;
             }
-            int val;
-            token = token_it.next(&token_it);
-            sk_str_init(&str_token, token, 10);
-            parse_int(&str_token, 10, &val);
-            sk_str_destroy(&str_token);
-            tiles[i][j] = val;
-        }
-
-        token_it.destroy(&token_it);
 
-        sk_str_destroy(&line);
+            // Only the master may cover a goal cell
+            cell = row * source->width + col;
+            if (PDB_WALL == builder->grid[cell] || (k && PDB_GOAL == builder->grid[cell])
+             || builder->occupied[cell])
+            {
+                return false;
+            }
+            builder->occupied[cell] = k + 1;
+        }
     }
 
-    state.game_state = ALLOC(*(state.game_state), 1);
-    state.game_state->width = width;
-    state.game_state->height = height;
-    state.game_state->tiles = tiles;
-
-    sk_str_destroy(resolved_path);
-    free(resolved_path);
-    close(input_fd);
-    return retval;
+    return true;
+}
 
-matrix_fill_fail:
+UINT_64 buildPatternTable(board_state *source, const pattern_database *pattern, UINT_64 entries, UINT_8 *table)
+{
+    level_info *level = &state.level;
+    UINT_64 num_pieces = pattern->num_pieces;
+    UINT_64 *binomials = patternBinomials();
+    pattern_builder builder;
+    builder.source = source;
+    builder.pattern = pattern;
+    builder.rows = ALLOC(*builder.rows, num_pieces * level->max_size);
+    builder.cols = ALLOC(*builder.cols, num_pieces * level->max_size);
+    builder.grid = ALLOC(*builder.grid, CELLS(source));
+    builder.occupied = ALLOC(*builder.occupied, CELLS(source));
+
+    UINT_16 *cells;
+    UINT_64 k;
+    UINT_64 i;
 
-    for (i = 0; i < height; ++i)
+    for (k = 0; k < num_pieces; ++k)
     {
-        free(tiles[i]);
+        cells = PIECE_CELLS(source, pattern->pieces[k]);
+        builder.sizes[k] = PIECE_SIZE(source, pattern->pieces[k]);
+        for (i = 0; i < builder.sizes[k]; ++i)
+        {
+            builder.rows[k * level->max_size + i] =
+                    (SINT_64)(cells[i] / source->width) - (SINT_64)(cells[0] / source->width);
+            builder.cols[k * level->max_size + i] =
+                    (SINT_64)(cells[i] % source->width) - (SINT_64)(cells[0] % source->width);
+        }
     }
-    free(tiles);
-dimensions_fail:
 
-    if (input_fd > 0)
+    for (i = 0; i < CELLS(source); ++i)
     {
-        close(input_fd);
+        builder.grid[i] = WALL == source->tiles[i] ? PDB_WALL : PDB_FREE;
     }
-open_fail:
-
-    sk_str_destroy(resolved_path);
-    free(resolved_path);
-resolve_file_fail:
-
-    return retval;
-}
-
-void outputGameState()
-{
-    if (!state.game_state)
+    for (i = 0; i < level->num_goals; ++i)
     {
-        return;
+        builder.grid[level->goals[i]] = PDB_GOAL;
     }
 
-    printf("%lu,%lu,\n",
-            state.game_state->width,
-            state.game_state->height);
-
-    UINT_64 i;
-    UINT_64 j;
-    for (i = 0; i < state.game_state->height; ++i)
+    // Every move can be undone, so searching outward from the goal placements gives each
+    //      placement its distance to the nearest of them
+    UINT_32 *queue = ALLOC(*queue, entries);
+    UINT_64 anchors[PDB_MAX_PIECES];
+    UINT_64 moved[PDB_MAX_PIECES];
+    UINT_64 head = 0;
+    UINT_64 tail = 0;
+    bool solved;
+
+    memset(table, PDB_UNREACHED, entries);
+    for (i = 0; i < entries; ++i)
     {
-        for (j = 0; j < state.game_state->width; ++j)
+        patternAnchors(pattern, binomials, i, anchors);
+        if (!placePattern(&builder, anchors))
         {
-            printf("%ld,", state.game_state->tiles[i][j]);
+            continue;
         }
 
-        printf("\n");
+        solved = true;
+        for (k = 0; k < level->num_goals; ++k)
+        {
+            solved = solved && 1 == builder.occupied[level->goals[k]];
+        }
+        if (solved)
+        {
+            table[i] = 0;
+            queue[tail++] = i;
+        }
     }
-}
 
-void printGameState(board_state *game_state)
-{
-    if (!game_state)
+    static const SINT_64 row_steps[4] = {-1, 1, 0, 0};
+    static const SINT_64 col_steps[4] = {0, 0, -1, 1};
+    UINT_64 largest = 0;
+    UINT_64 current;
+    UINT_64 next;
+    UINT_8 distance;
+    SINT_64 row;
+    SINT_64 col;
+    UINT_64 d;
+
+    while (head < tail)
     {
-        return;
-    }
+        current = queue[head++];
+        distance = table[current] + (table[current] < PDB_UNREACHED - 1);
+        patternAnchors(pattern, binomials, current, anchors);
 
-    state.printer->debug(state.printer, DEBUG_DETAILS,
-                        "%lu,%lu,\n",
-                        game_state->width,
-                        game_state->height);
+        for (k = 0; k < num_pieces; ++k)
+        {
+            for (d = 0; d < 4; ++d)
+            {
+                // An anchor leaving the live cells always lands on a wall
+                row = (SINT_64)(anchors[k] / level->live_width) + row_steps[d];
+                col = (SINT_64)(anchors[k] % level->live_width) + col_steps[d];
+                if (row < 0 || col < 0 || row >= (SINT_64)level->live_height || col >= (SINT_64)level->live_width)
+                {
+                    continue;
+                }
 
-    char *buffer = ALLOC(*buffer, game_state->width * 10);
-    char *curr = buffer;
+                memcpy(moved, anchors, sizeof(moved));
+                moved[k] = row * level->live_width + col;
+                if (!placePattern(&builder, moved))
+                {
+                    continue;
+                }
+
+                next = patternIndex(pattern, binomials, moved);
+                if (PDB_UNREACHED == table[next])
+                {
+                    table[next] = distance;
+                    queue[tail++] = next;
+                    if (distance > largest)
+                    {
+                        largest = distance;
+                    }
+                }
+            }
+        }
+    }
 
+    free(queue);
+    free(binomials);
+    free(builder.rows);
+    free(builder.cols);
+    free(builder.grid);
+    free(builder.occupied);
+    return largest;
+}
 
+bool writePatternFile(board_state *source, const char *path)
+{
+    level_info *level = &state.level;
+    UINT_64 live_cells = level->live_width * level->live_height;
+
+    // Pieces of one shape are interchangeable in the closed sets, so a database holds every
+    //      piece of a shape or none. Shapes nearest the goal get in the master's way first.
+    UINT_64 *order = ALLOC(*order, level->num_classes);
+    UINT_64 *nearest = ALLOC(*nearest, level->num_classes);
+    UINT_64 *members = ALLOC(*members, level->num_classes);
+    UINT_64 num_ordered = 0;
+    UINT_64 distance;
+    UINT_16 *cells;
+    SINT_64 rows;
+    SINT_64 cols;
+    SINT_64 piece;
+    UINT_64 c;
+    UINT_64 g;
     UINT_64 i;
     UINT_64 j;
-    for (i = 0; i < game_state->height; ++i)
+
+    for (c = 0; c < level->num_classes; ++c)
     {
-        curr = buffer;
-        for (j = 0; j < game_state->width; ++j)
+        nearest[c] = ~0UL;
+        members[c] = 0;
+    }
+
+    for (piece = MASTER + 1; piece <= source->max_piece; ++piece)
+    {
+        if (!PIECE_SIZE(source, piece))
         {
-            curr += sprintf(curr, "%ld,", game_state->tiles[i][j]);
+            continue;
         }
 
-        state.printer->debug(state.printer, DEBUG_DETAILS,
-                            "%s\n",
-                            buffer);
+        c = pieceClass(source, piece);
+        members[c]++;
+        cells = PIECE_CELLS(source, piece);
+        for (i = 0; i < PIECE_SIZE(source, piece); ++i)
+        {
+            for (g = 0; g < level->num_goals; ++g)
+            {
+                rows = (SINT_64)(cells[i] / source->width) - (SINT_64)(level->goals[g] / source->width);
+                cols = (SINT_64)(cells[i] % source->width) - (SINT_64)(level->goals[g] % source->width);
+                distance = (rows < 0 ? -rows : rows) + (cols < 0 ? -cols : cols);
+                if (distance < nearest[c])
+                {
+                    nearest[c] = distance;
+                }
+            }
+        }
     }
 
-    free(buffer);
-}
+    for (c = 1; c < level->num_classes; ++c)
+    {
+        for (j = num_ordered; j > 0 && nearest[order[j - 1]] > nearest[c]; --j)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = c;
+        num_ordered++;
+    }
 
-bool cloneGameState(board_state *source, board_state *dest)
-{
-    if (!source || !dest)
+    pattern_file_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PDB_MAGIC, sizeof(header.magic));
+    header.layout = levelLayoutHash(source);
+    header.live_cells = live_cells;
+
+    // Shapes join the current database while its table stays within PDB_MAX_ENTRIES
+    UINT_64 *binomials = patternBinomials();
+    UINT_64 radix;
+    pattern_file_entry *entry = &header.databases[header.count++];
+    entry->pieces[entry->num_pieces++] = MASTER;
+    entry->groups[entry->num_groups++] = 1;
+    entry->entries = live_cells;
+    for (i = 0; i < num_ordered; ++i)
     {
-        return false;
+        c = order[i];
+        radix = PDB_BINOMIAL(binomials, live_cells, members[c]);
+        if (members[c] + 1 > PDB_MAX_PIECES || live_cells * radix > PDB_MAX_ENTRIES)
+        {
+            continue;
+        }
+        if (entry->num_pieces + members[c] > PDB_MAX_PIECES || entry->entries * radix > PDB_MAX_ENTRIES)
+        {
+            if (PDB_MAX_DATABASES == header.count)
+            {
+                break;
+            }
+            entry = &header.databases[header.count++];
+            entry->pieces[entry->num_pieces++] = MASTER;
+            entry->groups[entry->num_groups++] = 1;
+            entry->entries = live_cells;
+        }
+
+        for (piece = MASTER + 1; piece <= source->max_piece; ++piece)
+        {
+            if (PIECE_SIZE(source, piece) && pieceClass(source, piece) == c)
+            {
+                entry->pieces[entry->num_pieces++] = piece;
+            }
+        }
+        entry->groups[entry->num_groups++] = members[c];
+        entry->entries *= radix;
     }
 
-    dest->width = source->width;
-    dest->height = source->height;
-    dest->tiles = ALLOC(*(dest->tiles), dest->height);
+    free(order);
+    free(nearest);
+    free(members);
+    free(binomials);
 
-    UINT_64 i, j;
-    for (i = 0; i < dest->height; ++i)
+    UINT_64 offset = (sizeof(header) + PDB_ALIGN - 1) / PDB_ALIGN * PDB_ALIGN;
+    for (i = 0; i < header.count; ++i)
     {
-        dest->tiles[i] = ALLOC(*(dest->tiles[i]), dest->width);
-        for (j = 0; j < dest->width; ++j)
+        entry = &header.databases[i];
+        for (j = 0; j < entry->num_pieces; ++j)
         {
-            dest->tiles[i][j] = source->tiles[i][j];
+            entry->shapes[j] = pieceShapeHash(source, entry->pieces[j]);
         }
+        entry->offset = offset;
+        offset += (entry->entries + PDB_ALIGN - 1) / PDB_ALIGN * PDB_ALIGN;
     }
-    return true;
-}
 
-bool gameStateSolved(board_state *source)
-{
-    if (!source)
+    FILE *out = fopen(path, "wb");
+    if (!out)
     {
+        printf("Error! Failed to create pattern file %s: %s\n", path, strerror(errno));
         return false;
     }
 
-    UINT_64 i, j;
-    for (i = 0; i < source->height; ++i)
+    struct timeval start, stop;
+    gettimeofday(&start, NULL);
+
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    pattern_database pattern;
+    UINT_8 *table;
+    UINT_64 largest;
+    UINT_64 reachable;
+    for (i = 0; ok && i < header.count; ++i)
     {
-        for (j = 0; j < source->width; ++j)
+        entry = &header.databases[i];
+        pattern.num_pieces = entry->num_pieces;
+        pattern.num_groups = entry->num_groups;
+        memcpy(pattern.pieces, entry->pieces, sizeof(pattern.pieces));
+        memcpy(pattern.groups, entry->groups, sizeof(pattern.groups));
+        table = ALLOC(*table, entry->entries);
+        largest = buildPatternTable(source, &pattern, entry->entries, table);
+
+        reachable = 0;
+        for (j = 0; j < entry->entries; ++j)
         {
-            if (source->tiles[i][j] == -1)
-            {
-                return false;
-            }
+            reachable += PDB_UNREACHED != table[j];
+        }
+
+        printf("Pattern Database %lu: pieces", i);
+        for (j = 0; j < entry->num_pieces; ++j)
+        {
+            printf(" %ld", entry->pieces[j]);
         }
+        printf(", %lu entries, %lu reach the goal, at most %lu moves\n", entry->entries, reachable, largest);
+
+        ok = fseek(out, entry->offset, SEEK_SET) == 0 && fwrite(table, 1, entry->entries, out) == entry->entries;
+        free(table);
+    }
+
+    // Pad the last table so the file maps whole
+    ok = ok && fseek(out, offset - 1, SEEK_SET) == 0 && fputc(0, out) != EOF;
+    ok = fclose(out) == 0 && ok;
+    if (!ok)
+    {
+        printf("Error! Failed to write pattern file %s.\n", path);
+        return false;
     }
+
+    gettimeofday(&stop, NULL);
+    printf("Pattern File: %lu databases, %lu bytes written to %s in %0.3f seconds\n", header.count, offset, path,
+            (stop.tv_sec - start.tv_sec) + (stop.tv_usec - start.tv_usec) / 1e6);
     return true;
 }
 
-void allMovesHelp(board_state *source, SINT_64 piece, sk_list *moves)
+bool loadPatternFile(board_state *source, const char *path, pattern_set *patterns)
 {
-    if (!moves)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
     {
-        return;
+        printf("Error! Failed to open pattern file %s: %s\n", path, strerror(errno));
+        return false;
     }
 
-    sk_list_init(moves, NULL);
+    struct stat info;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (UINT_64)info.st_size >= sizeof(pattern_file_header))
+    {
+        map = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        printf("Error! %s is not a pattern file.\n", path);
+        return false;
+    }
 
-    if (!source)
+    const pattern_file_header *header = map;
+    UINT_64 size = info.st_size;
+    UINT_64 live_cells = state.level.live_width * state.level.live_height;
+    if (memcmp(header->magic, PDB_MAGIC, sizeof(header->magic)) || header->count > PDB_MAX_DATABASES)
     {
-        return;
+        printf("Error! %s is not a pattern file.\n", path);
+        munmap(map, size);
+        return false;
+    }
+    if (header->layout != levelLayoutHash(source) || header->live_cells != live_cells)
+    {
+        printf("Error! %s was built for a different level.\n", path);
+        munmap(map, size);
+        return false;
     }
 
-    UINT_64 i, j;
-    bool move_possible = true;
+    // Keep the databases whose pieces still have the shapes they were built with, each group
+    //      holding every piece of its shape
+    UINT_64 *binomials = patternBinomials();
+    const pattern_file_entry *entry;
+    pattern_database *database;
+    UINT_64 entries;
+    UINT_64 members;
+    UINT_64 first;
+    SINT_64 piece;
+    bool usable;
+    UINT_64 c;
+    UINT_64 g;
+    UINT_64 i;
+    UINT_64 k;
 
-    // UP
-    for (i = 0; i < source->height; ++i)
+    patterns->count = 0;
+    for (i = 0; i < header->count; ++i)
     {
-        for (j = 0; j < source->width; ++j)
+        entry = &header->databases[i];
+        usable = entry->num_pieces > 0 && entry->num_pieces <= PDB_MAX_PIECES && MASTER == entry->pieces[0]
+              && entry->num_groups > 0 && entry->num_groups <= entry->num_pieces && 1 == entry->groups[0];
+        for (k = 0; usable && k < entry->num_pieces; ++k)
         {
-            if (source->tiles[i][j] == piece)
+            usable = entry->pieces[k] >= MASTER && entry->pieces[k] <= source->max_piece
+                  && PIECE_SIZE(source, entry->pieces[k])
+                  && entry->shapes[k] == pieceShapeHash(source, entry->pieces[k]);
+            for (g = 0; usable && g < k; ++g)
             {
-                if ( !(  CLEAR == source->tiles[i - 1][j]
-                      || piece == source->tiles[i - 1][j]
-                      || (  MASTER == piece
-                         && GOAL == source->tiles[i - 1][j]
-                         )
-                      )
-                   )
-                {
-                    move_possible = false;
-                }
+                usable = entry->pieces[g] != entry->pieces[k];
             }
         }
-    }
-
-    if (move_possible)
-    {
-        move *next_move = ALLOC(*next_move, 1);
-        next_move->piece = piece;
-        next_move->dir = UP;
-        sk_list_append(moves, next_move);
-    }
 
-    // DOWN
-    move_possible = true;
-
-    for (i = source->height - 1; /*i >= 0*/; --i)
-    {
-        for (j = 0; j < source->width; ++j)
+        entries = 1;
+        first = 0;
+        for (g = 0; usable && g < entry->num_groups; ++g)
         {
-            if (source->tiles[i][j] == piece)
+            usable = entry->groups[g] > 0 && entry->groups[g] <= entry->num_pieces - first;
+            c = usable ? pieceClass(source, entry->pieces[first]) : 0;
+            for (k = first; usable && k < first + entry->groups[g]; ++k)
             {
-                if ( !(  CLEAR == source->tiles[i + 1][j]
-                      || piece == source->tiles[i + 1][j]
-                      || (  MASTER == piece
-                         && GOAL == source->tiles[i + 1][j]
-                         )
-                      )
-                   )
-                {
-                    move_possible = false;
-                }
+                usable = pieceClass(source, entry->pieces[k]) == c;
             }
+
+            members = 0;
+            for (piece = MASTER; usable && piece <= source->max_piece; ++piece)
+            {
+                members += PIECE_SIZE(source, piece) && pieceClass(source, piece) == c;
+            }
+            usable = usable && members == entry->groups[g];
+
+            entries *= usable ? PDB_BINOMIAL(binomials, live_cells, entry->groups[g]) : 1;
+            usable = usable && entries <= PDB_MAX_ENTRIES;
+            first += usable ? entry->groups[g] : 0;
         }
 
-        // Avoid unsigned infinite loop
-        if (i == 0)
+        if (!usable || first != entry->num_pieces || entry->entries != entries || entry->offset % PDB_ALIGN
+         || entry->offset > size || size - entry->offset < entries)
         {
-            break;
+            continue;
         }
+
+        database = &patterns->databases[patterns->count++];
+        database->num_pieces = entry->num_pieces;
+        database->num_groups = entry->num_groups;
+        memcpy(database->pieces, entry->pieces, sizeof(database->pieces));
+        memcpy(database->groups, entry->groups, sizeof(database->groups));
+        database->table = (const UINT_8 *)map + entry->offset;
     }
 
-    if (move_possible)
+    if (!patterns->count)
     {
-        move *next_move = ALLOC(*next_move, 1);
-        next_move->piece = piece;
-        next_move->dir = DOWN;
-        sk_list_append(moves, next_move);
+        printf("Error! No database of %s matches the pieces of this level.\n", path);
+        free(binomials);
+        munmap(map, size);
+        return false;
     }
 
-    // LEFT
-    move_possible = true;
+    patterns->binomials = binomials;
+    patterns->map = map;
+    patterns->map_size = size;
+    printf("Pattern Databases: %lu of %lu loaded from %s\n", patterns->count, header->count, path);
+    return true;
+}
+
+UINT_64 patternDistance(board_state *source)
+{
+    pattern_set *patterns = &state.patterns;
+    pattern_database *database;
+    UINT_64 anchors[PDB_MAX_PIECES];
+    UINT_64 best = 0;
+    UINT_64 index;
+    UINT_64 i;
+    UINT_64 k;
 
-    for (i = 0; i < source->height; ++i)
+    for (i = 0; i < patterns->count; ++i)
     {
-        for (j = 0; j < source->width; ++j)
+        database = &patterns->databases[i];
+        for (k = 0; k < database->num_pieces; ++k)
         {
-            if (source->tiles[i][j] == piece)
-            {
-                if ( !(  CLEAR == source->tiles[i][j - 1]
-                      || piece == source->tiles[i][j - 1]
-                      || (  MASTER == piece
-                         && GOAL == source->tiles[i][j - 1]
-                         )
-                      )
-                   )
-                {
-                    move_possible = false;
-                }
-            }
+            anchors[k] = liveAnchor(source, PIECE_CELLS(source, database->pieces[k])[0]);
+        }
+        index = patternIndex(database, patterns->binomials, anchors);
+
+        // A placement that cannot reach the goal bounds nothing the searches can use
+        if (PDB_UNREACHED != database->table[index] && database->table[index] > best)
+        {
+            best = database->table[index];
         }
     }
 
-    if (move_possible)
+    return best;
+}
+
+UINT_64 goalEstimate(board_state *source)
+{
+    UINT_64 manhattan = masterGoalDistance(source);
+    UINT_64 pattern = state.patterns.count ? patternDistance(source) : 0;
+    return pattern > manhattan ? pattern : manhattan;
+}
+
+bool solutionsEqual(sk_list *a, sk_list *b)
+{
+    if (sk_list_size(a) != sk_list_size(b))
     {
-        move *next_move = ALLOC(*next_move, 1);
-        next_move->piece = piece;
-        next_move->dir = LEFT;
-        sk_list_append(moves, next_move);
+        return false;
     }
 
-    // RIGHT
-    move_possible = true;
-
-    for (i = 0; i < source->height; ++i)
+    bool equal = true;
+    move *x;
+    move *y;
+    sk_iterator it_a;
+    sk_iterator it_b;
+    sk_list_begin(&it_a, a);
+    sk_list_begin(&it_b, b);
+    while (equal && it_a.has_next(&it_a) && it_b.has_next(&it_b))
     {
-        for (j = source->width - 1; /*j >= 0*/; --j)
-        {
-            if (source->tiles[i][j] == piece)
-            {
-                if ( !(  CLEAR == source->tiles[i][j + 1]
-                      || piece == source->tiles[i][j + 1]
-                      || (  MASTER == piece
-                         && GOAL == source->tiles[i][j + 1]
-                         )
-                      )
-                   )
-                {
-                    move_possible = false;
-                }
-            }
+        x = it_a.next(&it_a);
+        y = it_b.next(&it_b);
+        equal = x->piece == y->piece && x->dir == y->dir;
+    }
+    it_a.destroy(&it_a);
+    it_b.destroy(&it_b);
 
-            // Avoid unsigned infinite loop
-            if (j == 0)
-            {
-                break;
-            }
-        }
+    return equal;
+}
+
+void clearSolution(sk_list *soln)
+{
+    sk_iterator it;
+    sk_list_begin(&it, soln);
+    while (it.has_next(&it))
+    {
+        free(it.next(&it));
+        sk_list_remove(&it);
     }
+    it.destroy(&it);
+}
 
-    if (move_possible)
+void app_debug(struct printer *out, int level, char *fmt, ...)
+{
+    if (!out || out->debug_level < level || !fmt)
     {
-        move *next_move = ALLOC(*next_move, 1);
-        next_move->piece = piece;
-        next_move->dir = RIGHT;
-        sk_list_append(moves, next_move);
+        return;
     }
 
+    // Debug messages are printed on standard output only
+    va_list ap;
+    va_start(ap, fmt);
+    standard_error(out, "[DEBUG] ");
+    standard_error_va(out, fmt, ap);
 }
 
-void allMoves(board_state *source, sk_list *moves)
+void handle_f(sk_str *match, sk_str **args, void *handle)
 {
-    if (!moves)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    sk_list_init(moves, NULL);
+    if (!resolve_input_file(arg->string, &state->resolved_path))
+    {
+        state->printer->error(state->printer, "Failed to parse filename: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Resolved file path to %s\n",
+                                state->resolved_path->string);
+    }
+}
 
-    if (!source)
+void handle_r(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    SINT_64 max = 3;
-
-    UINT_64 i, j;
-    for (i = 0; i < source->height; ++i)
+    int N = 0;
+    if (!parse_int(arg, 0, &N))
     {
-        for (j = 0; j < source->width; ++j)
-        {
-            if (source->tiles[i][j] > max)
-            {
-                max = source->tiles[i][j];
-            }
-        }
+        state->printer->error(state->printer, "Failed to parse as int: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating random walk step count to %d\n",
+                                N);
+        state->N = N;
+        state->random_walk = true;
     }
+}
 
-    for (i = 2; i < (UINT_64)max + 1; ++i)
+void handle_d(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
-        sk_list new_moves;
-        allMovesHelp(source, i, &new_moves);
-        sk_iterator it;
-        move *next_move = NULL;
-        sk_list_begin(&it, &new_moves);
-        while (it.has_next(&it))
-        {
-            next_move = it.next(&it);
-            sk_list_append(moves, next_move);
-            sk_list_remove(&it);
-        }
-        it.destroy(&it);
-        sk_list_destroy(&new_moves);
+        return;
     }
+
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to depth first search mode.\n");
+    state->depth_first = true;
 }
 
-void applyMove(board_state *source, move next_move)
+void handle_b(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source)
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
         return;
     }
 
-    UINT_64 i, j;
-    bool move_possible = true;
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to breadth first search mode.\n");
+    state->breadth_first = true;
+}
 
-    switch (next_move.dir)
+void handle_bitboard(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
-    case UP:
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (move_possible && source->tiles[i][j] == next_move.piece)
-                {
-                    if ( !(  CLEAR == source->tiles[i - 1][j]
-                          || next_move.piece == source->tiles[i - 1][j]
-                          || (  MASTER == source->tiles[i][j]
-                             && GOAL == source->tiles[i - 1][j]
-                             )
-                          )
-                       )
-                    {
-                        move_possible = false;
-                    }
-                }
-            }
-        }
-        if (!move_possible)
-        {
-            break;
-        }
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (source->tiles[i][j] == next_move.piece)
-                {
-                    source->tiles[i - 1][j] = next_move.piece;
-                    source->tiles[i][j] = CLEAR;
-                }
-            }
-        }
-        break;
-    case DOWN:
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (move_possible && source->tiles[i][j] == next_move.piece)
-                {
-                    if ( !(  CLEAR == source->tiles[i + 1][j]
-                          || next_move.piece == source->tiles[i + 1][j]
-                          || (  MASTER == source->tiles[i][j]
-                             && GOAL == source->tiles[i + 1][j]
-                             )
-                          )
-                       )
-                    {
-                        move_possible = false;
-                    }
-                }
-            }
-        }
-        if (!move_possible)
-        {
-            break;
-        }
-        for (i = source->height - 1; /* i >= 0 */; --i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (source->tiles[i][j] == next_move.piece)
-                {
-                    source->tiles[i + 1][j] = next_move.piece;
-                    source->tiles[i][j] = CLEAR;
-                }
-            }
-            // Avoid unsigned infinite loop
-            if (i == 0)
-            {
-                break;
-            }
-        }
-        break;
-    case LEFT:
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (move_possible && source->tiles[i][j] == next_move.piece)
-                {
-                    if ( !(  CLEAR == source->tiles[i][j - 1]
-                          || next_move.piece == source->tiles[i][j - 1]
-                          || (  MASTER == source->tiles[i][j]
-                             && GOAL == source->tiles[i][j - 1]
-                             )
-                          )
-                       )
-                    {
-                        move_possible = false;
-                    }
-                }
-            }
-        }
-        if (!move_possible)
-        {
-            break;
-        }
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (source->tiles[i][j] == next_move.piece)
-                {
-                    source->tiles[i][j - 1] = next_move.piece;
-                    source->tiles[i][j] = CLEAR;
-                }
-            }
-        }
-        break;
-    case RIGHT:
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = 0; j < source->width; ++j)
-            {
-                if (move_possible && source->tiles[i][j] == next_move.piece)
-                {
-                    if ( !(  CLEAR == source->tiles[i][j + 1]
-                          || next_move.piece == source->tiles[i][j + 1]
-                          || (  MASTER == source->tiles[i][j]
-                             && GOAL == source->tiles[i][j + 1]
-                             )
-                          )
-                       )
-                    {
-                        move_possible = false;
-                    }
-                }
-            }
-        }
-        if (!move_possible)
-        {
-            break;
-        }
-        for (i = 0; i < source->height; ++i)
-        {
-            for (j = source->width - 1; /*j >= 0*/; --j)
-            {
-                if (source->tiles[i][j] == next_move.piece)
-                {
-                    source->tiles[i][j + 1] = next_move.piece;
-                    source->tiles[i][j] = CLEAR;
-                }
-                // Avoid unsigned infinite loop
-                if (j == 0)
-                {
-                    break;
-                }
-            }
-        }
-        break;
-    default:
-        break;
+        return;
     }
+
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to bitboard move engine.\n");
+    state->engine = ENGINE_BITBOARD;
 }
 
-void applyMoveCloning(board_state *source, move next_move, board_state *dest)
+void handle_i(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source || !dest)
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
         return;
     }
 
-    cloneGameState(source, dest);
-    applyMove(dest, next_move);
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to iterative deepening search mode.\n");
+    state->iterative_deepening = true;
 }
 
-void tile_swap(board_state *source, SINT_64 target, SINT_64 replacement)
+void handle_tt(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    UINT_64 i, j;
-    for (i = 0; i < source->height; ++i)
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 0)
     {
-        for (j = 0; j < source->width; ++j)
-        {
-            if (source->tiles[i][j] == target)
-            {
-                source->tiles[i][j] = replacement;
-            }
-        }
+        state->printer->error(state->printer, "Failed to parse as entry count: %s\n", arg->string);
     }
-}
-
-bool stateEqual(const void *a, const void *b)
-{
-    const board_state *A = a;
-    const board_state *B = b;
-
-    if (!A || !B || A->width != B->width || A->height != B->height)
+    else
     {
-        return false;
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating transposition table size to %d entries\n",
+                                N);
+        state->tt_entries = N;
     }
+}
 
-
-    UINT_64 i, j;
-    for (i = 0; i < A->height; ++i)
+void handle_a(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
-        for (j = 0; j < A->width; ++j)
-        {
-            if (A->tiles[i][j] != B->tiles[i][j])
-            {
-                return false;
-            }
-        }
+        return;
     }
 
-    return true;
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to A* search mode.\n");
+    state->astar = true;
 }
 
-void normalizeState(board_state *source)
+void handle_ida(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source)
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
         return;
     }
 
-    UINT_64 i, j;
-    // shift all tile numbers to be larger than any possible cell number
-    for (i = 0; i < source->height; ++i)
-    {
-        for (j = 0; j < source->width; ++j)
-        {
-            switch (source->tiles[i][j])
-            {
-            case WALL:
-            case CLEAR:
-            case GOAL:
-            case MASTER:
-                break;
-            default:
-                source->tiles[i][j] += (source->height * source->width + 3);
-                break;
-            }
-        }
-    }
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to IDA* search mode.\n");
+    state->ida_star = true;
+}
 
-    // replace each block number with the smallest cell number it covers
-    for (i = 0; i < source->height; ++i)
+void handle_bidir(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
-        for (j = 0; j < source->width; ++j)
-        {
-            if (  WALL == source->tiles[i][j]
-               || CLEAR == source->tiles[i][j]
-               || GOAL == source->tiles[i][j]
-               || MASTER == source->tiles[i][j]
-               )
-            {
-                continue;
-            }
-            if (source->tiles[i][j] > (SINT_64)((i * source->width) + j + 3))
-            {
-                tile_swap(source, source->tiles[i][j], (i * source->width) + j + 3);
-            }
-        }
+        return;
     }
 
-    // Condense block indices into regularly increasing indices starting at 3
-    UINT_64 current_index = 3;
-    for (i = 0; i < source->height; ++i)
-    {
-        for (j = 0; j < source->width; ++j)
-        {
-            if (source->tiles[i][j] == (SINT_64)((i * source->width) + j + 3))
-            {
-                tile_swap(source, source->tiles[i][j], current_index++);
-            }
-        }
-    }
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to bidirectional search mode.\n");
+    state->bidirectional = true;
 }
 
-void destroy_board_state(void *p)
+void handle_pb(sk_str *match, sk_str **args, void *handle)
 {
-    if (!p)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    board_state *state = p;
-
-    UINT_64 i;
-    for (i = 0; i < state->height; ++i)
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        free(state->tiles[i]);
+        state->printer->error(state->printer, "Failed to parse as thread count: %s\n", arg->string);
     }
-    free(state->tiles);
-}
-
-UINT_64 hashBoardState(const void *element, UINT_64 size)
-{
-    if (!element)
+    else
     {
-        return 0;
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating to parallel breadth first search mode with %d threads.\n",
+                                N);
+        state->parallel_threads = N;
     }
+}
 
-    UINT_64 hash = 0;
-
-    UINT_64 i, j;
-
-    const board_state *state = element;
-
-    // Shift - Add - XOR Hash
-    for (i = 0; i < state->height; ++i)
+void handle_scaling(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
     {
-        for (j = 0; j < state->width; ++j)
-        {
-            if (state->tiles[i][j] != WALL && state->tiles[i][j] != GOAL)
-            {
-                hash ^= (hash << 5) + (hash >> 2) + state->tiles[i][j];
-            }
-        }
+        return;
     }
 
-    return hash % size;
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Enabling thread scaling runs.\n");
+    state->scaling = true;
 }
 
-void randomWalks(board_state *source, UINT_64 N)
+void handle_hda(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    UINT_64 i, j;
-    sk_list moves;
-    sk_iterator it;
-    UINT_64 num_moves;
-    UINT_64 move_idx;
-    move *next_move;
-    for (i = 0; i <= N; ++i)
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        outputGameState();
-        if (i == N)
-        {
-            break;
-        }
-
-        if (gameStateSolved(source))
-        {
-            break;
-        }
-
-        allMoves(source, &moves);
-        num_moves = sk_list_size(&moves);
-        if (num_moves == 0)
-        {
-            printf("Error! No moves found for given board state!\n");
-            outputGameState();
-            break;
-        }
-        move_idx = state.random.rand_64bit(&state.random) % num_moves;
-
-        state.printer->debug(state.printer, DEBUG_DETAILS,
-                                "Selected move %lu / %lu\n",
-                                move_idx + 1,
-                                num_moves);
-
-        j = 0;
-        sk_list_begin(&it, &moves);
-        while (it.has_next(&it))
-        {
-            next_move = it.next(&it);
-
-            if (j++ == move_idx)
-            {
-                printf("\n");
-                switch (next_move->dir)
-                {
-                case UP:
-                    printf("(%ld, up)\n", next_move->piece);
-                    break;
-                case DOWN:
-                    printf("(%ld, down)\n", next_move->piece);
-                    break;
-                case LEFT:
-                    printf("(%ld, left)\n", next_move->piece);
-                    break;
-                case RIGHT:
-                    printf("(%ld, right)\n", next_move->piece);
-                    break;
-                }
-                printf("\n");
-
-                applyMove(source, *next_move);
-            }
-            else
-            {
-                state.printer->debug(state.printer, DEBUG_DETAILS,
-                                        "Potential move (%d,%d)\n",
-                                        next_move->piece,
-                                        next_move->dir);
-            }
-            free(next_move);
-            sk_list_remove(&it);
-        }
-        it.destroy(&it);
-        sk_list_destroy(&moves);
-
-        normalizeState(source);
+        state->printer->error(state->printer, "Failed to parse as thread count: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating to hash distributed A* search mode with %d threads.\n",
+                                N);
+        state->hda_threads = N;
     }
-
-    printf("\n");
-    printf("Random walk terminated after %lu moves.\n", i);
-
 }
 
-bool uninformedDepthFirst(board_state *source, sk_hash_table *closed, sk_list *open, sk_list *soln, UINT_64 *nodes_visited)
+void handle_pd(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source || !closed || !open || !soln)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
-        return false;
+        return;
     }
 
-    struct depth_node;
-    typedef struct depth_node depth_node;
-
-    struct depth_node
-    {
-        board_state *state;
-        sk_list move_list;
-    };
-
-    depth_node *root = ALLOC(*root, 1);
-    root->state = ALLOC(*(root->state), 1);
-    cloneGameState(source, root->state);
-    sk_list_init(&root->move_list, NULL);
-    sk_list_append(open, root);
-    (*nodes_visited)++;
-
-    // Currently considered node
-    depth_node *current;
-    // Next node to add to the open list
-    depth_node *next;
-    // Normalized state of \c next to check for repeated states
-    board_state *normalized_next_state;
-    // Iterator across closed list
-    sk_iterator check_it;
-    // Next state in the check list to consider
-    board_state *next_check_state;
-    // List of moves possible in the current state
-    sk_list moves;
-    // Iterator across the move list
-    sk_iterator move_it;
-    // Next move to consider
-    move *next_move;
-
-    while (!sk_list_empty(open))
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        current = sk_list_pop_head(open);
-
-        (*nodes_visited)++;
-        state.printer->debug(state.printer, DEBUG_DETAILS,
-                            "Considering:\n");
-        printGameState(current->state);
-
-        if (gameStateSolved(current->state))
-        {
-            // Populate the solution list with the winning moves
-            sk_iterator soln_it;
-            sk_list_begin(&soln_it, &current->move_list);
-            while (soln_it.has_next(&soln_it))
-            {
-                move *next_move = soln_it.next(&soln_it);
-                move *cloned = ALLOC(*cloned, 1);
-                *cloned = *next_move;
-                sk_list_append(soln, cloned);
-
-                free(next_move);
-                sk_list_remove(&soln_it);
-            }
-            soln_it.destroy(&soln_it);
-
-            destroy_board_state(current->state);
-            free(current->state);
-            sk_list_destroy(&current->move_list);
-            free(current);
-
-            // Free all elements from the open list
-            sk_iterator open_it;
-            sk_list_begin(&open_it, open);
-            while (open_it.has_next(&open_it))
-            {
-                current = open_it.next(&open_it);
-                destroy_board_state(current->state);
-                free(current->state);
-                sk_iterator soln_it;
-                sk_list_begin(&soln_it, &current->move_list);
-                while (soln_it.has_next(&soln_it))
-                {
-                    free(soln_it.next(&soln_it));
-                    sk_list_remove(&soln_it);
-                }
-                soln_it.destroy(&soln_it);
-                sk_list_destroy(&current->move_list);
-                free(current);
-            }
-            open_it.destroy(&open_it);
-
-            sk_iterator closed_it;
-            sk_hash_table_begin(&closed_it, closed);
-            while (closed_it.has_next(&closed_it))
-            {
-                board_state *current = closed_it.next(&closed_it);
-                destroy_board_state(current);
-                free(current);
-            }
-            closed_it.destroy(&closed_it);
-
-            return true;
-        }
-
-        allMoves(current->state, &moves);
-        if (sk_list_size(&moves) == 0)
-        {
-            printf("Error! No moves found for given board state!\n");
-            sk_list_destroy(&moves);
-
-            destroy_board_state(current->state);
-            free(current->state);
-            sk_iterator soln_it;
-            sk_list_begin(&soln_it, &current->move_list);
-            while (soln_it.has_next(&soln_it))
-            {
-                free(soln_it.next(&soln_it));
-                sk_list_remove(&soln_it);
-            }
-            soln_it.destroy(&soln_it);
-            sk_list_destroy(&current->move_list);
-            free(current);
-
-            sk_iterator open_it;
-            sk_list_begin(&open_it, open);
-            while (open_it.has_next(&open_it))
-            {
-                depth_node *current = open_it.next(&open_it);
-
-                // Destroy the node we just visited
-                destroy_board_state(current->state);
-                free(current->state);
-                sk_iterator soln_it;
-                sk_list_begin(&soln_it, &current->move_list);
-                while (soln_it.has_next(&soln_it))
-                {
-                    free(soln_it.next(&soln_it));
-                    sk_list_remove(&soln_it);
-                }
-                soln_it.destroy(&soln_it);
-                sk_list_destroy(&current->move_list);
-                free(current);
-            }
-            open_it.destroy(&open_it);
-
-            sk_iterator closed_it;
-            sk_hash_table_begin(&closed_it, closed);
-            while (closed_it.has_next(&closed_it))
-            {
-                board_state *current = closed_it.next(&closed_it);
-                destroy_board_state(current);
-                free(current);
-            }
-            closed_it.destroy(&closed_it);
-
-            return false;
-        }
-
-        while (!sk_list_empty(&moves))
-        {
-            // Reverse the list order for LIFO queue processing
-            next_move = sk_list_pop_tail(&moves);
-            next = ALLOC(*next, 1);
-            next->state = ALLOC(*(next->state), 1);
-            applyMoveCloning(current->state, *next_move, next->state);
-
-            normalized_next_state = ALLOC(*normalized_next_state, 1);
-            cloneGameState(next->state, normalized_next_state);
-            normalizeState(normalized_next_state);
-
-            // If we haven't visited an equivalent state yet, add the normalized
-            //      state to the closed list and the new state to the open list
-            if (!sk_hash_table_contains(closed, normalized_next_state))
-            {
-                sk_hash_table_put(closed, normalized_next_state);
-
-                // Update the next node with the list of moves required to reach it
-                sk_list_init(&next->move_list, NULL);
-                sk_iterator soln_it;
-                sk_list_begin(&soln_it, &current->move_list);
-                while (soln_it.has_next(&soln_it))
-                {
-                    move *next_move = soln_it.next(&soln_it);
-                    move *cloned = ALLOC(*cloned, 1);
-                    *cloned = *next_move;
-                    sk_list_append(&next->move_list, cloned);
-                }
-                soln_it.destroy(&soln_it);
-
-                move *cloned = ALLOC(*cloned, 1);
-                *cloned = *next_move;
-                sk_list_append(&next->move_list, cloned);
-
-                sk_list_prepend(open, next);
-            }
-            else
-            {
-                state.printer->debug(state.printer, DEBUG_DETAILS,
-                                    "FOUND DUPLICATE\n");
-
-                destroy_board_state(next->state);
-                free(next->state);
-                free(next);
-
-                destroy_board_state(normalized_next_state);
-                free(normalized_next_state);
-            }
-
-            free(next_move);
-        }
-        sk_list_destroy(&moves);
-
-        // Destroy the node we just visited
-        destroy_board_state(current->state);
-        free(current->state);
-        sk_iterator soln_it;
-        sk_list_begin(&soln_it, &current->move_list);
-        while (soln_it.has_next(&soln_it))
-        {
-            free(soln_it.next(&soln_it));
-            sk_list_remove(&soln_it);
-        }
-        soln_it.destroy(&soln_it);
-        sk_list_destroy(&current->move_list);
-        free(current);
+        state->printer->error(state->printer, "Failed to parse as thread count: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating to work-stealing depth first search mode with %d threads.\n",
+                                N);
+        state->stealing_threads = N;
     }
-
-    return false;
 }
 
-bool uninformedBreadthFirst(board_state *source, sk_hash_table *closed, sk_list *open, sk_list *soln, UINT_64 *nodes_visited)
+void handle_closed(sk_str *match, sk_str **args, void *handle)
 {
-    if (!source || !closed || !open || !soln)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
-        return false;
+        return;
     }
 
-    struct breadth_node;
-    typedef struct breadth_node breadth_node;
-
-    struct breadth_node
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        board_state *state;
-        sk_list move_list;
-    };
-
-    breadth_node *root = ALLOC(*root, 1);
-    root->state = ALLOC(*(root->state), 1);
-    cloneGameState(source, root->state);
-    sk_list_init(&root->move_list, NULL);
-    sk_list_append(open, root);
-    (*nodes_visited)++;
-
-    // Currently considered node
-    breadth_node *current;
-    // Next node to add to the open list
-    breadth_node *next;
-    // Normalized state of \c next to check for repeated states
-    board_state *normalized_next_state;
-    // Iterator across closed list
-    sk_iterator check_it;
-    // Next state in the check list to consider
-    board_state *next_check_state;
-    // List of moves possible in the current state
-    sk_list moves;
-    // Iterator across the move list
-    sk_iterator move_it;
-    // Next move to consider
-    move *next_move;
-
-    while (!sk_list_empty(open))
+        state->printer->error(state->printer, "Failed to parse as entry count: %s\n", arg->string);
+    }
+    else
     {
-        current = sk_list_pop_head(open);
-
-        allMoves(current->state, &moves);
-        if (sk_list_size(&moves) == 0)
-        {
-            printf("Error! No moves found for given board state!\n");
-            sk_list_destroy(&moves);
-
-            destroy_board_state(current->state);
-            free(current->state);
-            sk_iterator soln_it;
-            sk_list_begin(&soln_it, &current->move_list);
-            while (soln_it.has_next(&soln_it))
-            {
-                free(soln_it.next(&soln_it));
-                sk_list_remove(&soln_it);
-            }
-            soln_it.destroy(&soln_it);
-            sk_list_destroy(&current->move_list);
-            free(current);
-
-            sk_iterator closed_it;
-            sk_hash_table_begin(&closed_it, closed);
-            while (closed_it.has_next(&closed_it))
-            {
-                board_state *current = closed_it.next(&closed_it);
-                destroy_board_state(current);
-                free(current);
-            }
-            closed_it.destroy(&closed_it);
-
-            return false;
-        }
-
-        sk_list_begin(&move_it, &moves);
-        while (move_it.has_next(&move_it))
-        {
-            next_move = move_it.next(&move_it);
-            next = ALLOC(*next, 1);
-            next->state = ALLOC(*(next->state), 1);
-            applyMoveCloning(current->state, *next_move, next->state);
-
-            if (gameStateSolved(next->state))
-            {
-                // Destroy the new node we created
-                destroy_board_state(next->state);
-                free(next->state);
-                free(next);
-
-                // Populate the solution list with the winning moves
-                sk_iterator soln_it;
-                sk_list_begin(&soln_it, &current->move_list);
-                while (soln_it.has_next(&soln_it))
-                {
-                    move *next_move = soln_it.next(&soln_it);
-                    move *cloned = ALLOC(*cloned, 1);
-                    *cloned = *next_move;
-                    sk_list_append(soln, cloned);
-                    free(next_move);
-                    sk_list_remove(&soln_it);
-                }
-                soln_it.destroy(&soln_it);
-                move *cloned = ALLOC(*cloned, 1);
-                *cloned = *next_move;
-                sk_list_append(soln, cloned);
-
-                // Destroy the move list
-                free(next_move);
-                sk_list_remove(&move_it);
-                while (move_it.has_next(&move_it))
-                {
-                    free(move_it.next(&move_it));
-                    sk_list_remove(&move_it);
-                }
-                move_it.destroy(&move_it);
-                sk_list_destroy(&moves);
-
-                destroy_board_state(current->state);
-                free(current->state);
-                sk_list_destroy(&current->move_list);
-                free(current);
-
-                // Free all elements from the open list
-                sk_iterator open_it;
-                sk_list_begin(&open_it, open);
-                while (open_it.has_next(&open_it))
-                {
-                    current = open_it.next(&open_it);
-                    destroy_board_state(current->state);
-                    free(current->state);
-                    sk_iterator soln_it;
-                    sk_list_begin(&soln_it, &current->move_list);
-                    while (soln_it.has_next(&soln_it))
-                    {
-                        free(soln_it.next(&soln_it));
-                        sk_list_remove(&soln_it);
-                    }
-                    soln_it.destroy(&soln_it);
-                    sk_list_destroy(&current->move_list);
-                    free(current);
-                }
-                open_it.destroy(&open_it);
-
-                sk_iterator closed_it;
-                sk_hash_table_begin(&closed_it, closed);
-                while (closed_it.has_next(&closed_it))
-                {
-                    board_state *current = closed_it.next(&closed_it);
-                    destroy_board_state(current);
-                    free(current);
-                }
-                closed_it.destroy(&closed_it);
-
-                return true;
-            }
-
-            normalized_next_state = ALLOC(*normalized_next_state, 1);
-            cloneGameState(next->state, normalized_next_state);
-            normalizeState(normalized_next_state);
-
-            // If we haven't visited an equivalent state yet, add the normalized
-            //      state to the closed list and the new state to the open list
-            if (!sk_hash_table_contains(closed, normalized_next_state))
-            {
-                sk_hash_table_put(closed, normalized_next_state);
-
-                state.printer->debug(state.printer, DEBUG_DETAILS,
-                                    "Considering:\n");
-                printGameState(next->state);
-                (*nodes_visited)++;
-
-                // Update the next node with the list of moves required to reach it
-                sk_list_init(&next->move_list, NULL);
-                sk_iterator soln_it;
-                sk_list_begin(&soln_it, &current->move_list);
-                while (soln_it.has_next(&soln_it))
-                {
-                    move *next_move = soln_it.next(&soln_it);
-                    move *cloned = ALLOC(*cloned, 1);
-                    *cloned = *next_move;
-                    sk_list_append(&next->move_list, cloned);
-                }
-                soln_it.destroy(&soln_it);
-
-                move *cloned = ALLOC(*cloned, 1);
-                *cloned = *next_move;
-                sk_list_append(&next->move_list, cloned);
-
-                sk_list_append(open, next);
-            }
-            else
-            {
-                state.printer->debug(state.printer, DEBUG_DETAILS,
-                                    "FOUND DUPLICATE\n");
-
-                destroy_board_state(next->state);
-                free(next->state);
-                free(next);
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating parallel closed set size to %d entries\n",
+                                N);
+        state->closed_entries = N;
+    }
+}
 
-                destroy_board_state(normalized_next_state);
-                free(normalized_next_state);
-            }
+void handle_setbench(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
+    {
+        return;
+    }
 
-            free(next_move);
-            sk_list_remove(&move_it);
-        }
-        move_it.destroy(&move_it);
-        sk_list_destroy(&moves);
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
+    {
+        state->printer->error(state->printer, "Failed to parse as thread count: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating to atomic key set benchmark mode up to %d threads.\n",
+                                N);
+        state->set_bench_threads = N;
+    }
+}
 
-        // Destroy the node we just visited
-        destroy_board_state(current->state);
-        free(current->state);
-        sk_iterator soln_it;
-        sk_list_begin(&soln_it, &current->move_list);
-        while (soln_it.has_next(&soln_it))
-        {
-            free(soln_it.next(&soln_it));
-            sk_list_remove(&soln_it);
-        }
-        soln_it.destroy(&soln_it);
-        sk_list_destroy(&current->move_list);
-        free(current);
+void handle_pipe(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    if (!match || !args || !handle)
+    {
+        return;
     }
 
-    return false;
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Updating to pipelined breadth first search mode.\n");
+    state->pipelined = true;
 }
 
-void app_debug(struct printer *out, int level, char *fmt, ...)
+void handle_mp(sk_str *match, sk_str **args, void *handle)
 {
-    if (!out || out->debug_level < level || !fmt)
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
-    // Debug messages are printed on standard output only
-    va_list ap;
-    va_start(ap, fmt);
-    standard_error(out, "[DEBUG] ");
-    standard_error_va(out, fmt, ap);
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
+    {
+        state->printer->error(state->printer, "Failed to parse as process count: %s\n", arg->string);
+    }
+    else
+    {
+        state->printer->debug(state->printer, DEBUG_DETAILS,
+                                "Updating to multi-process breadth first search mode with %d workers.\n",
+                                N);
+        state->mp_workers = N;
+    }
 }
 
-void handle_f(sk_str *match, sk_str **args, void *handle)
+void handle_ext(sk_str *match, sk_str **args, void *handle)
 {
     global_state *state = handle;
     sk_str *arg = args[1];
@@ -1988,19 +9451,36 @@ void handle_f(sk_str *match, sk_str **args, void *handle)
         return;
     }
 
-    if (!resolve_input_file(arg->string, &state->resolved_path))
+    int N = 0;
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        state->printer->error(state->printer, "Failed to parse filename: %s\n", arg->string);
+        state->printer->error(state->printer, "Failed to parse as megabytes: %s\n", arg->string);
     }
     else
     {
         state->printer->debug(state->printer, DEBUG_DETAILS,
-                                "Resolved file path to %s\n",
-                                state->resolved_path->string);
+                                "Updating to external memory breadth first search mode with %d MB.\n",
+                                N);
+        state->ext_memory = (UINT_64)N << 20;
     }
 }
 
-void handle_r(sk_str *match, sk_str **args, void *handle)
+void handle_checkpoint(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
+    {
+        return;
+    }
+
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Writing search snapshots to %s.\n", arg->string);
+    free(state->checkpoint.path);
+    state->checkpoint.path = strdup(arg->string);
+}
+
+void handle_interval(sk_str *match, sk_str **args, void *handle)
 {
     global_state *state = handle;
     sk_str *arg = args[1];
@@ -2010,44 +9490,61 @@ void handle_r(sk_str *match, sk_str **args, void *handle)
     }
 
     int N = 0;
-    if (!parse_int(arg, 0, &N))
+    if (!parse_int(arg, 0, &N) || N < 1)
     {
-        state->printer->error(state->printer, "Failed to parse as int: %s\n", arg->string);
+        state->printer->error(state->printer, "Failed to parse as seconds: %s\n", arg->string);
     }
     else
     {
         state->printer->debug(state->printer, DEBUG_DETAILS,
-                                "Updating random walk step count to %d\n",
-                                N);
-        state->N = N;
-        state->random_walk = true;
+                                "Updating snapshot interval to %d seconds.\n", N);
+        state->checkpoint.interval = N;
     }
 }
 
-void handle_d(sk_str *match, sk_str **args, void *handle)
+void handle_resume(sk_str *match, sk_str **args, void *handle)
 {
     global_state *state = handle;
-    if (!match || !args || !handle)
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
     state->printer->debug(state->printer, DEBUG_DETAILS,
-                            "Updating to depth first search mode.\n");
-    state->depth_first = true;
+                            "Resuming the search from %s.\n", arg->string);
+    free(state->checkpoint.resume);
+    state->checkpoint.resume = strdup(arg->string);
 }
 
-void handle_b(sk_str *match, sk_str **args, void *handle)
+void handle_pdbbuild(sk_str *match, sk_str **args, void *handle)
 {
     global_state *state = handle;
-    if (!match || !args || !handle)
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
     {
         return;
     }
 
     state->printer->debug(state->printer, DEBUG_DETAILS,
-                            "Updating to breadth first search mode.\n");
-    state->breadth_first = true;
+                            "Building pattern databases into %s.\n", arg->string);
+    free(state->pdb_build_path);
+    state->pdb_build_path = strdup(arg->string);
+}
+
+void handle_pdb(sk_str *match, sk_str **args, void *handle)
+{
+    global_state *state = handle;
+    sk_str *arg = args[1];
+    if (!match || !args || !arg || !handle)
+    {
+        return;
+    }
+
+    state->printer->debug(state->printer, DEBUG_DETAILS,
+                            "Using pattern databases from %s.\n", arg->string);
+    free(state->pdb_path);
+    state->pdb_path = strdup(arg->string);
 }
 
 void handle_verbose(sk_str *match, sk_str **args, void *handle)
@@ -2104,6 +9601,126 @@ bool interpret_input_arguments(global_state *state, int argc, char **argv)
             .argc = 0,
             .handler = handle_b
         },
+        // Iterative deepening search mode
+        {
+            .keyword = "i",
+            .argc = 0,
+            .handler = handle_i
+        },
+        // A* search mode
+        {
+            .keyword = "a",
+            .argc = 0,
+            .handler = handle_a
+        },
+        // IDA* search mode
+        {
+            .keyword = "ida",
+            .argc = 0,
+            .handler = handle_ida
+        },
+        // Bidirectional search mode
+        {
+            .keyword = "bidir",
+            .argc = 0,
+            .handler = handle_bidir
+        },
+        // Parallel breadth first search mode
+        {
+            .keyword = "pb",
+            .argc = 1,
+            .handler = handle_pb
+        },
+        // Thread scaling runs of the parallel search
+        {
+            .keyword = "scaling",
+            .argc = 0,
+            .handler = handle_scaling
+        },
+        // Hash distributed A* search mode
+        {
+            .keyword = "hda",
+            .argc = 1,
+            .handler = handle_hda
+        },
+        // Work-stealing depth first search mode
+        {
+            .keyword = "pd",
+            .argc = 1,
+            .handler = handle_pd
+        },
+        // Parallel closed set size
+        {
+            .keyword = "closed",
+            .argc = 1,
+            .handler = handle_closed
+        },
+        // Atomic key set benchmark mode
+        {
+            .keyword = "setbench",
+            .argc = 1,
+            .handler = handle_setbench
+        },
+        // Pipelined breadth first search mode
+        {
+            .keyword = "pipe",
+            .argc = 0,
+            .handler = handle_pipe
+        },
+        // Multi-process breadth first search mode
+        {
+            .keyword = "mp",
+            .argc = 1,
+            .handler = handle_mp
+        },
+        // External memory breadth first search mode
+        {
+            .keyword = "ext",
+            .argc = 1,
+            .handler = handle_ext
+        },
+        // Search snapshot file
+        {
+            .keyword = "checkpoint",
+            .argc = 1,
+            .handler = handle_checkpoint
+        },
+        // Seconds between search snapshots
+        {
+            .keyword = "interval",
+            .argc = 1,
+            .handler = handle_interval
+        },
+        // Search snapshot to resume from
+        {
+            .keyword = "resume",
+            .argc = 1,
+            .handler = handle_resume
+        },
+        // Pattern database precomputation mode
+        {
+            .keyword = "pdbbuild",
+            .argc = 1,
+            .handler = handle_pdbbuild
+        },
+        // Pattern databases of the informed searches
+        {
+            .keyword = "pdb",
+            .argc = 1,
+            .handler = handle_pdb
+        },
+        // Transposition table size
+        {
+            .keyword = "tt",
+            .argc = 1,
+            .handler = handle_tt
+        },
+        // Bitboard move engine
+        {
+            .keyword = "bitboard",
+            .argc = 0,
+            .handler = handle_bitboard
+        },
         // Verbose mode
         {
             .keyword = "verbose",
@@ -2161,19 +9778,43 @@ bool validate_global_state(global_state *state)
         return false;
     }
 
-    if (state->random_walk && state->breadth_first)
+    if (state->random_walk + state->depth_first + state->breadth_first + state->iterative_deepening
+      + state->astar + state->ida_star + state->bidirectional
+      + (state->parallel_threads > 0) + (state->hda_threads > 0) + (state->stealing_threads > 0)
+      + (state->set_bench_threads > 0) + state->pipelined
+      + (state->mp_workers > 0) + (state->ext_memory > 0) + (state->pdb_build_path != NULL) > 1)
     {
         state->printer->error(state->printer, "Error: Conflicting solution algorithms selected.");
         return false;
     }
-    else if (state->random_walk && state->depth_first)
+
+    if (state->scaling && !state->parallel_threads)
     {
-        state->printer->error(state->printer, "Error: Conflicting solution algorithms selected.");
+        state->printer->error(state->printer, "Error: Thread scaling requires the parallel search.");
         return false;
     }
-    else if (state->depth_first && state->breadth_first)
+
+    if ((state->checkpoint.path || state->checkpoint.resume) && !state->depth_first && !state->breadth_first)
     {
-        state->printer->error(state->printer, "Error: Conflicting solution algorithms selected.");
+        state->printer->error(state->printer, "Error: Snapshots require the depth first or breadth first search.");
+        return false;
+    }
+
+    if (state->pdb_path && !state->astar && !state->ida_star && !state->hda_threads)
+    {
+        state->printer->error(state->printer, "Error: Pattern databases require an informed search.");
+        return false;
+    }
+
+    if (state->tt_entries != TT_ENTRIES_UNSET && !state->iterative_deepening && !state->ida_star)
+    {
+        state->printer->error(state->printer, "Error: Transposition tables require the iterative deepening or IDA* search.");
+        return false;
+    }
+
+    if (state->closed_entries && !state->stealing_threads)
+    {
+        state->printer->error(state->printer, "Error: Closed set sizing requires the work-stealing search.");
         return false;
     }
 
@@ -2188,6 +9829,23 @@ void destroy_global_state(void *p)
     }
     global_state *state = p;
 
+    free(state->checkpoint.path);
+    free(state->checkpoint.resume);
+    state->checkpoint.path = NULL;
+    state->checkpoint.resume = NULL;
+
+    if (state->patterns.map)
+    {
+        munmap(state->patterns.map, state->patterns.map_size);
+        state->patterns.map = NULL;
+    }
+    free(state->patterns.binomials);
+    state->patterns.binomials = NULL;
+    free(state->pdb_build_path);
+    free(state->pdb_path);
+    state->pdb_build_path = NULL;
+    state->pdb_path = NULL;
+
     if (state->resolved_path)
     {
         sk_str_destroy(state->resolved_path);
@@ -2197,15 +9855,12 @@ void destroy_global_state(void *p)
 
     if (state->game_state)
     {
-        UINT_64 i;
-        for (i = 0; i < state->game_state->height; ++i)
-        {
-            free(state->game_state->tiles[i]);
-        }
-        free(state->game_state->tiles);
+        destroy_board_state(state->game_state);
         free(state->game_state);
         state->game_state = NULL;
     }
+
+    destroy_level_info(&state->level);
 }
 
 bool resolve_input_file(const char *filename, sk_str **resolved)
@@ -0,0 +1,138 @@
+/*
+ * sk_arena.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_arena.h"
+
+// malloc, free
+#include <stdlib.h>
+
+// Alignment of every allocation handed out
+#define ARENA_ALIGN         16
+
+// Rounds \c size up to the next multiple of ARENA_ALIGN
+#define ARENA_ROUND(size)   (((size) + ARENA_ALIGN - 1) & ~(UINT_64)(ARENA_ALIGN - 1))
+
+// Bytes at the start of every chunk holding the link to the previous chunk
+#define CHUNK_HEADER        ARENA_ROUND(sizeof(UINT_8 *))
+
+void sk_arena_init(sk_arena *arena, UINT_64 chunk_size)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    arena->chunk_size = chunk_size > CHUNK_HEADER ? chunk_size : CHUNK_HEADER + ARENA_ALIGN;
+    arena->chunk = NULL;
+    arena->used = 0;
+    arena->capacity = 0;
+    arena->chunks = 0;
+    arena->bytes = 0;
+}
+
+void *sk_arena_alloc(sk_arena *arena, UINT_64 size)
+{
+    if (!arena)
+    {
+        return NULL;
+    }
+
+    size = ARENA_ROUND(size ? size : 1);
+    if (!arena->chunk || arena->used + size > arena->capacity)
+    {
+        // Oversized requests get a chunk of their own; the rest of the current one is abandoned
+        UINT_64 capacity = arena->chunk_size;
+        if (CHUNK_HEADER + size > capacity)
+        {
+            capacity = CHUNK_HEADER + size;
+        }
+
+        UINT_8 *chunk = malloc(capacity);
+        if (!chunk)
+        {
+            return NULL;
+        }
+
+        *(UINT_8 **)chunk = arena->chunk;
+        arena->chunk = chunk;
+        arena->used = CHUNK_HEADER;
+        arena->capacity = capacity;
+        arena->chunks++;
+        arena->bytes += capacity;
+    }
+
+    void *result = arena->chunk + arena->used;
+    arena->used += size;
+    return result;
+}
+
+void sk_arena_destroy(sk_arena *arena)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    UINT_8 *chunk = arena->chunk;
+    UINT_8 *previous;
+    while (chunk)
+    {
+        previous = *(UINT_8 **)chunk;
+        free(chunk);
+        chunk = previous;
+    }
+
+    arena->chunk = NULL;
+    arena->used = 0;
+    arena->capacity = 0;
+}
+
+void sk_pool_init(sk_pool *pool, sk_arena *arena, UINT_64 object_size)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    // Released objects store the free list link in their first bytes
+    if (object_size < sizeof(void *))
+    {
+        object_size = sizeof(void *);
+    }
+
+    pool->arena = arena;
+    pool->object_size = ARENA_ROUND(object_size);
+    pool->free_list = NULL;
+}
+
+void *sk_pool_alloc(sk_pool *pool)
+{
+    if (!pool)
+    {
+        return NULL;
+    }
+
+    if (pool->free_list)
+    {
+        void *object = pool->free_list;
+        pool->free_list = *(void **)object;
+        return object;
+    }
+
+    return sk_arena_alloc(pool->arena, pool->object_size);
+}
+
+void sk_pool_free(sk_pool *pool, void *object)
+{
+    if (!pool || !object)
+    {
+        return;
+    }
+
+    *(void **)object = pool->free_list;
+    pool->free_list = object;
+}
@@ -0,0 +1,194 @@
+/*
+ * sk_atomic_key_set.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_atomic_key_set.h"
+
+// memcmp, memcpy
+#include <string.h>
+
+// ALLOC
+#include "utils.h"
+
+// Segments are chosen by the top SEGMENT_BITS fingerprint bits
+#define SEGMENT_BITS    6
+#define SEGMENTS        (1 << SEGMENT_BITS)
+
+// A segment takes no more keys once count / capacity would exceed MAX_LOAD_NUM / MAX_LOAD_DEN
+#define MAX_LOAD_NUM    7
+#define MAX_LOAD_DEN    10
+
+#define MIN_SEGMENT_CAPACITY    16
+
+// Set on a claimed slot until its key bytes are written. Stored fingerprints never carry
+//      it, and fingerprint 0 marks an empty slot, so such keys are stored as 1.
+#define PENDING                 (1UL << 63)
+#define SLOT_FINGERPRINT(f)     (((f) & ~PENDING) ? ((f) & ~PENDING) : 1)
+
+/**
+ * @brief                   Finds \c key in \c set, claiming an empty slot for it if absent
+ *                              and \c claim is set.
+ *
+ * @param[in] set           - Set to search
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - Key to look for
+ * @param[in] claim         - Whether to insert an absent key
+ *
+ * @return                  An SK_KEY_SET_ result. Without \c claim an absent key reads as
+ *                              SK_KEY_SET_FULL.
+ */
+int sk_atomic_key_set_probe(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key, bool claim);
+
+bool sk_atomic_key_set_init(sk_atomic_key_set *set, UINT_64 key_size, UINT_64 size_hint)
+{
+    if (!set)
+    {
+        return false;
+    }
+
+    UINT_64 per_segment = size_hint / SEGMENTS + 1;
+    UINT_64 capacity = MIN_SEGMENT_CAPACITY;
+    while (capacity * MAX_LOAD_NUM < per_segment * MAX_LOAD_DEN)
+    {
+        capacity *= 2;
+    }
+
+    memset(set, 0, sizeof(*set));
+    set->key_size = key_size;
+    set->segment_capacity = capacity;
+    set->capacity = capacity * SEGMENTS;
+    set->segments = ALLOC(sk_key_segment, SEGMENTS);
+    set->fingerprints = ALLOC(_Atomic UINT_64, set->capacity);
+    set->keys = ALLOC(UINT_8, set->capacity * key_size + 1);
+    if (!set->segments || !set->fingerprints || !set->keys)
+    {
+        sk_atomic_key_set_destroy(set);
+        return false;
+    }
+
+    UINT_64 i;
+    for (i = 0; i < SEGMENTS; ++i)
+    {
+        atomic_init(&set->segments[i].count, 0);
+        set->segments[i].limit = capacity * MAX_LOAD_NUM / MAX_LOAD_DEN;
+    }
+    for (i = 0; i < set->capacity; ++i)
+    {
+        atomic_init(&set->fingerprints[i], 0);
+    }
+    return true;
+}
+
+int sk_atomic_key_set_probe(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key, bool claim)
+{
+    fingerprint = SLOT_FINGERPRINT(fingerprint);
+
+    sk_key_segment *segment = &set->segments[fingerprint >> (63 - SEGMENT_BITS) & (SEGMENTS - 1)];
+    UINT_64 base = (segment - set->segments) * set->segment_capacity;
+    UINT_64 mask = set->segment_capacity - 1;
+    UINT_64 slot = fingerprint & mask;
+    UINT_64 probe;
+    UINT_64 found;
+
+    // A segment is never filled, so every probe sequence reaches an empty slot
+    for (probe = 0; probe <= mask; ++probe, slot = (slot + 1) & mask)
+    {
+        found = atomic_load_explicit(&set->fingerprints[base + slot], memory_order_acquire);
+
+        if (!found)
+        {
+            if (!claim)
+            {
+                return SK_KEY_SET_FULL;
+            }
+
+            // Reserve room in the segment before taking the slot
+            if (atomic_fetch_add_explicit(&segment->count, 1, memory_order_relaxed) >= segment->limit)
+            {
+                atomic_fetch_sub_explicit(&segment->count, 1, memory_order_relaxed);
+                return SK_KEY_SET_FULL;
+            }
+
+            if (atomic_compare_exchange_strong_explicit(&set->fingerprints[base + slot], &found,
+                                                        fingerprint | PENDING,
+                                                        memory_order_acquire, memory_order_acquire))
+            {
+                memcpy(&set->keys[(base + slot) * set->key_size], key, set->key_size);
+                atomic_store_explicit(&set->fingerprints[base + slot], fingerprint, memory_order_release);
+                return SK_KEY_SET_INSERTED;
+            }
+
+            // Another thread took the slot first: give the room back and examine its key
+            atomic_fetch_sub_explicit(&segment->count, 1, memory_order_relaxed);
+        }
+
+        // A matching slot still being written may hold this very key
+        while (found == (fingerprint | PENDING))
+        {
+            found = atomic_load_explicit(&set->fingerprints[base + slot], memory_order_acquire);
+        }
+
+        if (found == fingerprint
+         && !memcmp(&set->keys[(base + slot) * set->key_size], key, set->key_size))
+        {
+            return SK_KEY_SET_PRESENT;
+        }
+    }
+
+    return SK_KEY_SET_FULL;
+}
+
+int sk_atomic_key_set_insert(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key)
+{
+    if (!set || !key)
+    {
+        return SK_KEY_SET_FULL;
+    }
+
+    return sk_atomic_key_set_probe(set, fingerprint, key, true);
+}
+
+bool sk_atomic_key_set_contains(sk_atomic_key_set *set, UINT_64 fingerprint, const void *key)
+{
+    if (!set || !key)
+    {
+        return false;
+    }
+
+    return SK_KEY_SET_PRESENT == sk_atomic_key_set_probe(set, fingerprint, key, false);
+}
+
+UINT_64 sk_atomic_key_set_count(sk_atomic_key_set *set)
+{
+    if (!set || !set->segments)
+    {
+        return 0;
+    }
+
+    UINT_64 count = 0;
+    UINT_64 i;
+    for (i = 0; i < SEGMENTS; ++i)
+    {
+        count += atomic_load(&set->segments[i].count);
+    }
+    return count;
+}
+
+void sk_atomic_key_set_destroy(sk_atomic_key_set *set)
+{
+    if (!set)
+    {
+        return;
+    }
+
+    free(set->segments);
+    free((void *)set->fingerprints);
+    free(set->keys);
+    set->segments = NULL;
+    set->fingerprints = NULL;
+    set->keys = NULL;
+    set->capacity = 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * sk_bucket_queue.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_bucket_queue.h"
+
+// memset
+#include <string.h>
+
+// ALLOC, REALLOC
+#include "utils.h"
+
+#define INITIAL_BUCKETS     64
+#define INITIAL_ITEMS       16
+
+void sk_bucket_queue_init(sk_bucket_queue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    queue->buckets = NULL;
+    queue->num_buckets = 0;
+    queue->min = 0;
+    queue->size = 0;
+}
+
+bool sk_bucket_queue_push(sk_bucket_queue *queue, UINT_64 priority, void *element)
+{
+    if (!queue)
+    {
+        return false;
+    }
+
+    if (priority >= queue->num_buckets)
+    {
+        UINT_64 num_buckets = queue->num_buckets ? queue->num_buckets : INITIAL_BUCKETS;
+        while (num_buckets <= priority)
+        {
+            num_buckets *= 2;
+        }
+
+        sk_bucket *buckets = REALLOC(queue->buckets, sk_bucket, num_buckets);
+        if (!buckets)
+        {
+            return false;
+        }
+        memset(&buckets[queue->num_buckets], 0, (num_buckets - queue->num_buckets) * sizeof(*buckets));
+        queue->buckets = buckets;
+        queue->num_buckets = num_buckets;
+    }
+
+    sk_bucket *bucket = &queue->buckets[priority];
+    if (bucket->size == bucket->capacity)
+    {
+        UINT_64 capacity = bucket->capacity ? bucket->capacity * 2 : INITIAL_ITEMS;
+        void **items = REALLOC(bucket->items, void *, capacity);
+        if (!items)
+        {
+            return false;
+        }
+        bucket->items = items;
+        bucket->capacity = capacity;
+    }
+
+    bucket->items[bucket->size++] = element;
+    if (!queue->size || priority < queue->min)
+    {
+        queue->min = priority;
+    }
+    queue->size++;
+    return true;
+}
+
+void *sk_bucket_queue_pop(sk_bucket_queue *queue, UINT_64 *priority)
+{
+    if (!queue || !queue->size)
+    {
+        return NULL;
+    }
+
+    while (!queue->buckets[queue->min].size)
+    {
+        queue->min++;
+    }
+
+    if (priority)
+    {
+        *priority = queue->min;
+    }
+    queue->size--;
+    sk_bucket *bucket = &queue->buckets[queue->min];
+    return bucket->items[--bucket->size];
+}
+
+bool sk_bucket_queue_empty(const sk_bucket_queue *queue)
+{
+    return !queue || !queue->size;
+}
+
+void sk_bucket_queue_destroy(sk_bucket_queue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    UINT_64 i;
+    for (i = 0; i < queue->num_buckets; ++i)
+    {
+        free(queue->buckets[i].items);
+    }
+    free(queue->buckets);
+    queue->buckets = NULL;
+    queue->num_buckets = 0;
+    queue->size = 0;
+}
@@ -0,0 +1,376 @@
+/*
+ * sk_key_table.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_key_table.h"
+
+// memcmp, memcpy
+#include <string.h>
+
+// ALLOC
+#include "utils.h"
+
+// Grow once count / capacity would exceed MAX_LOAD_NUM / MAX_LOAD_DEN
+#define MAX_LOAD_NUM    7
+#define MAX_LOAD_DEN    10
+
+#define MIN_CAPACITY    16
+
+// Fingerprint 0 marks an empty slot, so keys fingerprinted 0 are stored as 1
+#define SLOT_FINGERPRINT(f)     ((f) ? (f) : 1)
+
+/**
+ * @brief                   Finds the slot holding \c key, or the empty slot where it belongs.
+ *
+ * @param[in] table         - Table to search
+ * @param[in] fingerprint   - Non-zero fingerprint of \c key
+ * @param[in] key           - Key to look for
+ *
+ * @return                  Slot index.
+ */
+UINT_64 sk_key_table_find(sk_key_table *table, UINT_64 fingerprint, const void *key);
+
+/**
+ * @brief                   Doubles the slot count of \c table and reinserts every key.
+ *
+ * @param[in] table         - Table to grow
+ *
+ * @return                  true if the new storage was allocated.
+ */
+bool sk_key_table_grow(sk_key_table *table);
+
+/**
+ * @brief                   Stores \c key in \c table unless it is already present.
+ *
+ * @param[in] table         - Table to insert into
+ * @param[in] fingerprint   - Fingerprint of \c key
+ * @param[in] key           - Key to store
+ * @param[in] value         - Value to store with the key if \c table is a map
+ *
+ * @return                  true if the key was absent and has been inserted.
+ */
+bool sk_key_table_add(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value);
+
+bool sk_key_table_init(sk_key_table *table, UINT_64 key_size, UINT_64 size_hint)
+{
+    if (!table)
+    {
+        return false;
+    }
+
+    UINT_64 capacity = MIN_CAPACITY;
+    while (capacity * MAX_LOAD_NUM < size_hint * MAX_LOAD_DEN)
+    {
+        capacity *= 2;
+    }
+
+    memset(table, 0, sizeof(*table));
+    table->key_size = key_size;
+    table->capacity = capacity;
+    table->fingerprints = ALLOC(UINT_64, capacity);
+    table->keys = ALLOC(UINT_8, capacity * key_size + 1);
+    if (!table->fingerprints || !table->keys)
+    {
+        sk_key_table_destroy(table);
+        return false;
+    }
+    return true;
+}
+
+bool sk_key_table_init_map(sk_key_table *table, UINT_64 key_size, UINT_64 size_hint)
+{
+    if (!sk_key_table_init(table, key_size, size_hint))
+    {
+        return false;
+    }
+
+    table->values = ALLOC(UINT_64, table->capacity);
+    if (!table->values)
+    {
+        sk_key_table_destroy(table);
+        return false;
+    }
+    return true;
+}
+
+UINT_64 sk_key_table_find(sk_key_table *table, UINT_64 fingerprint, const void *key)
+{
+    UINT_64 mask = table->capacity - 1;
+    UINT_64 slot = fingerprint & mask;
+    UINT_64 probe = 1;
+
+    while (table->fingerprints[slot])
+    {
+        if (table->fingerprints[slot] == fingerprint)
+        {
+            if (!memcmp(&table->keys[slot * table->key_size], key, table->key_size))
+            {
+                break;
+            }
+            table->false_matches++;
+        }
+        slot = (slot + 1) & mask;
+        probe++;
+    }
+
+    table->lookups++;
+    table->probes += probe;
+    if (probe > table->max_probe)
+    {
+        table->max_probe = probe;
+    }
+    return slot;
+}
+
+bool sk_key_table_grow(sk_key_table *table)
+{
+    UINT_64 capacity = table->capacity * 2;
+    UINT_64 *fingerprints = ALLOC(UINT_64, capacity);
+    UINT_8 *keys = ALLOC(UINT_8, capacity * table->key_size + 1);
+    UINT_64 *values = table->values ? ALLOC(UINT_64, capacity) : NULL;
+    if (!fingerprints || !keys || (table->values && !values))
+    {
+        free(fingerprints);
+        free(keys);
+        free(values);
+        return false;
+    }
+
+    // Every stored key is distinct, so reinsertion only needs the first empty slot
+    UINT_64 mask = capacity - 1;
+    UINT_64 i;
+    UINT_64 slot;
+    for (i = 0; i < table->capacity; ++i)
+    {
+        if (!table->fingerprints[i])
+        {
+            continue;
+        }
+
+        slot = table->fingerprints[i] & mask;
+        while (fingerprints[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+        fingerprints[slot] = table->fingerprints[i];
+        memcpy(&keys[slot * table->key_size], &table->keys[i * table->key_size], table->key_size);
+        if (values)
+        {
+            values[slot] = table->values[i];
+        }
+    }
+
+    free(table->fingerprints);
+    free(table->keys);
+    free(table->values);
+    table->fingerprints = fingerprints;
+    table->keys = keys;
+    table->values = values;
+    table->capacity = capacity;
+    table->resizes++;
+    return true;
+}
+
+bool sk_key_table_contains(sk_key_table *table, UINT_64 fingerprint, const void *key)
+{
+    if (!table || !key)
+    {
+        return false;
+    }
+
+    fingerprint = SLOT_FINGERPRINT(fingerprint);
+    return table->fingerprints[sk_key_table_find(table, fingerprint, key)] != 0;
+}
+
+bool sk_key_table_insert(sk_key_table *table, UINT_64 fingerprint, const void *key)
+{
+    return sk_key_table_add(table, fingerprint, key, 0);
+}
+
+bool sk_key_table_put(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value)
+{
+    return sk_key_table_add(table, fingerprint, key, value);
+}
+
+bool sk_key_table_set(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value)
+{
+    if (!table || !key || !table->values)
+    {
+        return false;
+    }
+
+    UINT_64 slot = sk_key_table_find(table, SLOT_FINGERPRINT(fingerprint), key);
+    if (table->fingerprints[slot])
+    {
+        table->values[slot] = value;
+        return true;
+    }
+    return sk_key_table_add(table, fingerprint, key, value);
+}
+
+bool sk_key_table_get(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 *value)
+{
+    if (!table || !key)
+    {
+        return false;
+    }
+
+    fingerprint = SLOT_FINGERPRINT(fingerprint);
+    UINT_64 slot = sk_key_table_find(table, fingerprint, key);
+    if (!table->fingerprints[slot])
+    {
+        return false;
+    }
+
+    if (value && table->values)
+    {
+        *value = table->values[slot];
+    }
+    return true;
+}
+
+bool sk_key_table_add(sk_key_table *table, UINT_64 fingerprint, const void *key, UINT_64 value)
+{
+    if (!table || !key)
+    {
+        return false;
+    }
+
+    fingerprint = SLOT_FINGERPRINT(fingerprint);
+    UINT_64 slot = sk_key_table_find(table, fingerprint, key);
+    if (table->fingerprints[slot])
+    {
+        return false;
+    }
+
+    if ((table->count + 1) * MAX_LOAD_DEN > table->capacity * MAX_LOAD_NUM)
+    {
+        if (!sk_key_table_grow(table))
+        {
+            return false;
+        }
+
+        // Locate the key's slot in the new layout without counting a second lookup
+        UINT_64 mask = table->capacity - 1;
+        slot = fingerprint & mask;
+        while (table->fingerprints[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    table->fingerprints[slot] = fingerprint;
+    memcpy(&table->keys[slot * table->key_size], key, table->key_size);
+    if (table->values)
+    {
+        table->values[slot] = value;
+    }
+    table->count++;
+    return true;
+}
+
+bool sk_key_table_write(const sk_key_table *table, FILE *out)
+{
+    if (!table || !out)
+    {
+        return false;
+    }
+
+    UINT_64 header[3] = {table->key_size, table->count, table->values != NULL};
+    bool ok = fwrite(header, sizeof(header), 1, out) == 1;
+
+    UINT_64 i;
+    for (i = 0; ok && i < table->capacity; ++i)
+    {
+        if (!table->fingerprints[i])
+        {
+            continue;
+        }
+
+        ok = fwrite(&table->fingerprints[i], sizeof(*table->fingerprints), 1, out) == 1
+          && fwrite(&table->keys[i * table->key_size], 1, table->key_size, out) == table->key_size
+          && (!table->values || fwrite(&table->values[i], sizeof(*table->values), 1, out) == 1);
+    }
+    return ok;
+}
+
+bool sk_key_table_read(sk_key_table *table, FILE *in)
+{
+    if (!table || !in)
+    {
+        return false;
+    }
+
+    UINT_64 header[3];
+    if (fread(header, sizeof(header), 1, in) != 1
+     || header[0] != table->key_size || header[2] != (table->values != NULL))
+    {
+        return false;
+    }
+
+    // Grow up front rather than once per doubling of the keys read
+    while ((table->count + header[1]) * MAX_LOAD_DEN > table->capacity * MAX_LOAD_NUM)
+    {
+        if (!sk_key_table_grow(table))
+        {
+            return false;
+        }
+    }
+
+    UINT_8 *key = ALLOC(UINT_8, table->key_size + 1);
+    UINT_64 fingerprint;
+    UINT_64 value = 0;
+    UINT_64 i;
+    bool ok = key != NULL;
+    for (i = 0; ok && i < header[1]; ++i)
+    {
+        ok = fread(&fingerprint, sizeof(fingerprint), 1, in) == 1
+          && fread(key, 1, table->key_size, in) == table->key_size
+          && (!table->values || fread(&value, sizeof(value), 1, in) == 1);
+        if (ok)
+        {
+            sk_key_table_add(table, fingerprint, key, value);
+        }
+    }
+
+    free(key);
+    return ok;
+}
+
+double sk_key_table_load_factor(const sk_key_table *table)
+{
+    if (!table || !table->capacity)
+    {
+        return 0.0;
+    }
+    return (double)table->count / table->capacity;
+}
+
+double sk_key_table_mean_probe(const sk_key_table *table)
+{
+    if (!table || !table->lookups)
+    {
+        return 0.0;
+    }
+    return (double)table->probes / table->lookups;
+}
+
+void sk_key_table_destroy(sk_key_table *table)
+{
+    if (!table)
+    {
+        return;
+    }
+
+    free(table->fingerprints);
+    free(table->keys);
+    free(table->values);
+    table->fingerprints = NULL;
+    table->keys = NULL;
+    table->values = NULL;
+    table->capacity = 0;
+    table->count = 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * sk_mailbox.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_mailbox.h"
+
+// NULL
+#include <stddef.h>
+
+void sk_mailbox_init(sk_mailbox *box)
+{
+    if (!box)
+    {
+        return;
+    }
+
+    atomic_init(&box->head, NULL);
+}
+
+void sk_mailbox_post(sk_mailbox *box, sk_mail *mail)
+{
+    if (!box || !mail)
+    {
+        return;
+    }
+
+    // A failed exchange reloads the current head into mail->next
+    mail->next = atomic_load_explicit(&box->head, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&box->head, &mail->next, mail,
+                                                  memory_order_release, memory_order_relaxed))
+    {
+        ;
+    }
+}
+
+sk_mail *sk_mailbox_collect(sk_mailbox *box)
+{
+    if (!box)
+    {
+        return NULL;
+    }
+
+    sk_mail *stack = atomic_exchange_explicit(&box->head, NULL, memory_order_acquire);
+
+    // The stack holds the newest message first
+    sk_mail *oldest = NULL;
+    sk_mail *next;
+    while (stack)
+    {
+        next = stack->next;
+        stack->next = oldest;
+        oldest = stack;
+        stack = next;
+    }
+    return oldest;
+}
+
+bool sk_mailbox_empty(sk_mailbox *box)
+{
+    return !box || !atomic_load_explicit(&box->head, memory_order_relaxed);
+}
@@ -0,0 +1,185 @@
+/*
+ * sk_record_file.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_record_file.h"
+
+// mkstemp
+#include <stdlib.h>
+
+// snprintf
+#include <stdio.h>
+
+// memcpy
+#include <string.h>
+
+// pread, pwrite, unlink, close
+#include <unistd.h>
+
+// errno, EINTR
+#include <errno.h>
+
+// PATH_MAX
+#include <limits.h>
+
+// ALLOC
+#include "utils.h"
+
+/**
+ * @brief                   Writes the buffered records of a writing stream to its file.
+ *
+ * @param[in] stream        - Stream to flush
+ *
+ * @return                  true if every byte was written.
+ */
+bool sk_record_stream_flush(sk_record_stream *stream);
+
+int sk_record_file_create(const char *dir)
+{
+    char path[PATH_MAX];
+    if (snprintf(path, sizeof(path), "%s/sbp-XXXXXX", dir ? dir : "/tmp") >= (int)sizeof(path))
+    {
+        return -1;
+    }
+
+    // The file lives on through its descriptor until closed
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        unlink(path);
+    }
+    return fd;
+}
+
+bool sk_record_file_read(int fd, UINT_64 record_size, UINT_64 index, void *record)
+{
+    UINT_8 *bytes = record;
+    UINT_64 offset = index * record_size;
+    ssize_t got;
+    while (record_size > 0)
+    {
+        got = pread(fd, bytes, record_size, offset);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        bytes += got;
+        offset += got;
+        record_size -= got;
+    }
+    return true;
+}
+
+bool sk_record_stream_open(sk_record_stream *stream, int fd, UINT_64 record_size, UINT_64 buffer_bytes,
+                           bool writing)
+{
+    if (!stream || !record_size)
+    {
+        return false;
+    }
+
+    stream->fd = fd;
+    stream->record_size = record_size;
+    stream->capacity = buffer_bytes / record_size * record_size;
+    if (!stream->capacity)
+    {
+        stream->capacity = record_size;
+    }
+    stream->buffer = ALLOC(*stream->buffer, stream->capacity);
+    stream->fill = 0;
+    stream->pos = 0;
+    stream->offset = 0;
+    stream->writing = writing;
+    return stream->buffer != NULL;
+}
+
+const UINT_8 *sk_record_stream_read(sk_record_stream *stream)
+{
+    if (stream->pos + stream->record_size > stream->fill)
+    {
+        // Refill the whole buffer. A trailing partial record is read again with the next block.
+        stream->offset += stream->pos;
+        stream->fill = 0;
+        stream->pos = 0;
+
+        ssize_t got;
+        while (stream->fill < stream->capacity)
+        {
+            got = pread(stream->fd, stream->buffer + stream->fill, stream->capacity - stream->fill,
+                        stream->offset + stream->fill);
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got <= 0)
+            {
+                break;
+            }
+            stream->fill += got;
+        }
+
+        if (stream->fill < stream->record_size)
+        {
+            return NULL;
+        }
+    }
+
+    const UINT_8 *record = stream->buffer + stream->pos;
+    stream->pos += stream->record_size;
+    return record;
+}
+
+bool sk_record_stream_write(sk_record_stream *stream, const void *record)
+{
+    if (stream->fill == stream->capacity && !sk_record_stream_flush(stream))
+    {
+        return false;
+    }
+
+    memcpy(stream->buffer + stream->fill, record, stream->record_size);
+    stream->fill += stream->record_size;
+    return true;
+}
+
+bool sk_record_stream_close(sk_record_stream *stream)
+{
+    if (!stream || !stream->buffer)
+    {
+        return false;
+    }
+
+    bool ok = !stream->writing || sk_record_stream_flush(stream);
+    free(stream->buffer);
+    stream->buffer = NULL;
+    return ok;
+}
+
+bool sk_record_stream_flush(sk_record_stream *stream)
+{
+    UINT_64 done = 0;
+    ssize_t written;
+    while (done < stream->fill)
+    {
+        written = pwrite(stream->fd, stream->buffer + done, stream->fill - done, stream->offset + done);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        done += written;
+    }
+
+    stream->offset += stream->fill;
+    stream->fill = 0;
+    return true;
+}
@@ -0,0 +1,68 @@
+/*
+ * sk_spsc_queue.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: agent
+ */
+
+#include "sk_spsc_queue.h"
+
+// ALLOC
+#include "utils.h"
+
+bool sk_spsc_queue_init(sk_spsc_queue *queue, UINT_64 capacity)
+{
+    if (!queue)
+    {
+        return false;
+    }
+
+    queue->capacity = 1;
+    while (queue->capacity < capacity)
+    {
+        queue->capacity *= 2;
+    }
+
+    queue->items = ALLOC(void *, queue->capacity);
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    return queue->items != NULL;
+}
+
+bool sk_spsc_queue_push(sk_spsc_queue *queue, void *item)
+{
+    UINT_64 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&queue->head, memory_order_acquire) == queue->capacity)
+    {
+        return false;
+    }
+
+    queue->items[tail & (queue->capacity - 1)] = item;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+void *sk_spsc_queue_pop(sk_spsc_queue *queue)
+{
+    UINT_64 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&queue->tail, memory_order_acquire))
+    {
+        return NULL;
+    }
+
+    void *item = queue->items[head & (queue->capacity - 1)];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return item;
+}
+
+void sk_spsc_queue_destroy(sk_spsc_queue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    free(queue->items);
+    queue->items = NULL;
+    queue->capacity = 0;
+}